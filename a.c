@@ -0,0 +1,2000 @@
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
+line 5 foo /* x */
+line 6 foo /* x */
+line 0 foo /* x */
+line 1 foo /* x */
+line 2 foo /* x */
+line 3 foo /* x */
+line 4 foo /* x */
@@ -0,0 +1,356 @@
+/*** defines ***/
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
+/*** includes ***/
+#include "buffer.hpp"
+#include "config.hpp"
+#include "perf.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <string>
+#include <vector>
+#include <functional>
+
+/*** corpus ***/
+struct BenchOptions {
+    int lines = 200000;
+    int width = 60;
+    int screen_rows = 50;
+    int screen_cols = 160;
+    int bulk = 2000;
+    const char *filter = NULL;
+    const char *json = NULL;
+};
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static uint32_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)rng_state;
+}
+
+/* Something that looks like C: keywords, numbers, strings, tabs and both
+ * kinds of comments, so every lexer path is exercised. */
+static std::string corpusLine(int width) {
+    static const char *words[] = {
+        "if", "while", "return", "struct", "int", "char", "unsigned", "void",
+        "value", "buffer", "offset", "count", "ptr", "len", "=", "+", "(", ")",
+        "{", "}", ";", ",", "42", "0x1f", "3.14", "\"text\"", "'c'", "->"
+    };
+    std::string s;
+    if (rnd() % 4 == 0) s += "\t";
+    int target = width / 2 + rnd() % (width + 1);
+    while ((int)s.size() < target) {
+        s += words[rnd() % (sizeof(words) / sizeof(words[0]))];
+        s += ' ';
+    }
+    if (rnd() % 10 == 0) s += "// trailing comment";
+    return s;
+}
+
+static std::string writeCorpus(const BenchOptions &opt, size_t *bytes) {
+    char path[] = "/tmp/edi_bench_XXXXXX.c";
+    int fd = mkstemps(path, 2);
+    if (fd == -1) {
+        perror("mkstemps");
+        exit(1);
+    }
+    FILE *f = fdopen(fd, "w");
+    *bytes = 0;
+    for (int j = 0; j < opt.lines; j++) {
+        std::string line = corpusLine(opt.width);
+        if (j % 97 == 0) line = "/* block comment start " + line;
+        if (j % 97 == 5) line += " end of block */";
+        line += '\n';
+        fwrite(line.data(), 1, line.size(), f);
+        *bytes += line.size();
+    }
+    fclose(f);
+    return path;
+}
+
+/* A log where most lines repeat: stack frames and heartbeats drawn from a
+ * small pool, with one unique request line in ten. */
+static std::string writeLog(const BenchOptions &opt, size_t *bytes) {
+    char path[] = "/tmp/edi_bench_XXXXXX.log";
+    int fd = mkstemps(path, 4);
+    if (fd == -1) {
+        perror("mkstemps");
+        exit(1);
+    }
+    FILE *f = fdopen(fd, "w");
+    *bytes = 0;
+    for (int j = 0; j < opt.lines; j++) {
+        char line[256];
+        int n;
+        if (rnd() % 10 == 0) {
+            n = snprintf(line, sizeof(line), "INFO request id=%d path=/api/v1/items/%u took %ums\n",
+                j, rnd() % 100000, rnd() % 500);
+        } else if (rnd() % 3 == 0) {
+            n = snprintf(line, sizeof(line), "DEBUG heartbeat from worker-%u: ok, queue depth 0\n",
+                rnd() % 8);
+        } else {
+            n = snprintf(line, sizeof(line), "\tat com.example.service.Handler%u.process(Handler%u.java:%u)\n",
+                rnd() % 16, rnd() % 16, 100 + rnd() % 4);
+        }
+        fwrite(line, 1, n, f);
+        *bytes += n;
+    }
+    fclose(f);
+    return path;
+}
+
+static uint64_t heapBytes() {
+    #ifdef __GLIBC__
+    return mallinfo2().uordblks;
+    #else
+    return 0;
+    #endif
+}
+
+static uint64_t bufferBytes(Buffer &b) {
+    uint64_t n = 0;
+    for (int j = 0; j < b.numrows; j++) n += b.rows[j].size + 1;
+    return n;
+}
+
+/*** measurement ***/
+struct BenchResult {
+    std::string name;
+    uint64_t ops;
+    uint64_t bytes;
+    uint64_t lines;
+    double seconds;
+    uint64_t allocs;
+    uint64_t heap;
+};
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static std::vector<BenchResult> results;
+
+static bool bench(const BenchOptions &opt, const char *name, uint64_t ops, uint64_t bytes,
+                  uint64_t lines, std::function<void()> fn) {
+    if (opt.filter && !strstr(name, opt.filter)) return false;
+
+    uint64_t allocs = perfAllocCount();
+    double start = now();
+    fn();
+    double seconds = now() - start;
+    allocs = perfAllocCount() - allocs;
+
+    BenchResult r = { name, ops, bytes, lines, seconds, allocs, 0 };
+    results.push_back(r);
+
+    fprintf(stderr, "%-28s %12.1f ns/op %10.1f MB/s %12.0f lines/s %8.2f allocs/op\n",
+        name, seconds * 1e9 / ops, bytes / seconds / 1e6, lines / seconds,
+        (double)allocs / ops);
+    return true;
+}
+
+static void writeJson(const BenchOptions &opt, FILE *f) {
+    fprintf(f, "{\n  \"lines\": %d,\n  \"width\": %d,\n  \"benchmarks\": [\n", opt.lines, opt.width);
+    for (size_t j = 0; j < results.size(); j++) {
+        const BenchResult &r = results[j];
+        fprintf(f, "    {\"name\": \"%s\", \"ops\": %llu, \"seconds\": %.9f, "
+            "\"ns_per_op\": %.3f, \"mb_per_s\": %.3f, \"lines_per_s\": %.1f, "
+            "\"allocs_per_op\": %.3f, \"heap_bytes\": %llu}%s\n",
+            r.name.c_str(), (unsigned long long)r.ops, r.seconds,
+            r.seconds * 1e9 / r.ops, r.bytes / r.seconds / 1e6, r.lines / r.seconds,
+            (double)r.allocs / r.ops, (unsigned long long)r.heap, j + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+/*** benchmarks ***/
+static void runAll(const BenchOptions &opt) {
+    size_t file_bytes;
+    std::string path = writeCorpus(opt, &file_bytes);
+
+    bench(opt, "open", 1, file_bytes, opt.lines, [&]() {
+        Buffer b;
+        b.editorOpen(path.c_str());
+    });
+
+    /* The heap a loaded log keeps, with and without shared line storage. */
+    size_t log_bytes;
+    std::string log = writeLog(opt, &log_bytes);
+    for (int intern = 0; intern < 2; intern++) {
+        cfg.config.intern_lines = intern;
+        uint64_t heap = 0;
+        const char *name = intern ? "open_log_interned" : "open_log";
+        if (bench(opt, name, 1, log_bytes, opt.lines, [&]() {
+            uint64_t before = heapBytes();
+            Buffer lb;
+            lb.editorOpen(log.c_str());
+            heap = heapBytes() - before;
+        })) {
+            results.back().heap = heap;
+            fprintf(stderr, "%-28s %12.1f heap bytes/line\n", "", (double)heap / opt.lines);
+        }
+    }
+    cfg.config.intern_lines = 0;
+    unlink(log.c_str());
+
+    Buffer b;
+    if (b.editorOpen(path.c_str()) == -1) {
+        perror("open");
+        exit(1);
+    }
+    uint64_t bytes = bufferBytes(b);
+
+    bench(opt, "update_row", b.numrows, bytes, b.numrows, [&]() {
+        for (int j = 0; j < b.numrows; j++) b.editorUpdateRow(&b.rows[j]);
+    });
+
+    bench(opt, "update_syntax_all", 1, bytes, b.numrows, [&]() {
+        b.editorUpdateSyntaxAll();
+    });
+
+    bench(opt, "update_syntax_row", b.numrows, bytes, b.numrows, [&]() {
+        for (int j = 0; j < b.numrows; j++) b.editorUpdateSyntax(&b.rows[j]);
+    });
+
+    /* Opening a comment on the first line of a file that never closes it
+     * re-lexes every row, and so does closing it again. */
+    Buffer cascade;
+    cascade.filename = strdup("cascade.c");
+    cascade.editorSelectSyntaxHighlight();
+    for (int j = 0; j < opt.lines; j++) {
+        std::string line = corpusLine(opt.width);
+        cascade.editorInsertRow(cascade.numrows, line.data(), line.size());
+    }
+    uint64_t cascade_bytes = bufferBytes(cascade);
+    bench(opt, "comment_cascade", 2, 2 * cascade_bytes, 2 * (uint64_t)cascade.numrows, [&]() {
+        cascade.editorInsertRow(0, "/*", 2);
+        cascade.editorDelRow(0);
+        cascade.editorUpdateSyntax(&cascade.rows[0]);
+    });
+
+    int frames = b.numrows / opt.screen_rows;
+    if (frames > 2000) frames = 2000;
+    if (frames < 1) frames = 1;
+    std::string ab;
+    ab.reserve(opt.screen_rows * (opt.screen_cols + 64));
+    auto drawFrames = [&]() {
+        uint64_t frame_bytes = 0;
+        for (int f = 0; f < frames; f++) {
+            ab.clear();
+            int top = (int)((uint64_t)f * b.numrows / frames);
+            for (int y = 0; y < opt.screen_rows; y++) {
+                if (top + y < b.numrows) b.editorDrawRow(ab, top + y, 0, opt.screen_cols);
+                else ab += '~';
+                ab += "\x1b[K\r\n";
+            }
+            frame_bytes += ab.size();
+        }
+        return frame_bytes;
+    };
+    /* The warm-up pass also tells how many bytes the frames produce. */
+    uint64_t frame_bytes = drawFrames();
+    bench(opt, "draw_rows", frames, frame_bytes, (uint64_t)frames * opt.screen_rows, [&]() {
+        drawFrames();
+    });
+
+    int match_rx;
+    bench(opt, "find_miss", 1, bytes, b.numrows, [&]() {
+        b.editorFindNext("no such needle", -1, 1, &match_rx);
+    });
+
+    bench(opt, "find_next", 100, 0, 0, [&]() {
+        int last = -1;
+        for (int j = 0; j < 100; j++) last = b.editorFindNext("->", last, 1, &match_rx);
+    });
+
+    std::string line = corpusLine(opt.width);
+    struct { const char *insert; const char *remove; double where; } sites[] = {
+        { "insert_head", "delete_head", 0.0 },
+        { "insert_middle", "delete_middle", 0.5 },
+        { "insert_tail", "delete_tail", 1.0 },
+    };
+    for (auto &site : sites) {
+        int at = (int)(b.numrows * site.where);
+        bench(opt, site.insert, opt.bulk, (uint64_t)opt.bulk * (line.size() + 1), opt.bulk, [&]() {
+            for (int j = 0; j < opt.bulk; j++) b.editorInsertRow(at, line.data(), line.size());
+        });
+        bench(opt, site.remove, opt.bulk, (uint64_t)opt.bulk * (line.size() + 1), opt.bulk, [&]() {
+            for (int j = 0; j < opt.bulk; j++) b.editorDelRow(at);
+        });
+    }
+
+    /* The row index alone, at three sizes: an edit in the middle should
+     * cost the same whatever the number of rows. */
+    struct { const char *name; size_t rows; } indexes[] = {
+        { "index_edit_10k", 10000 },
+        { "index_edit_100k", 100000 },
+        { "index_edit_1m", 1000000 },
+    };
+    for (auto &ix : indexes) {
+        Fenwick<int64_t> index;
+        index.assign(std::vector<int64_t>(ix.rows, opt.width + 1));
+        bench(opt, ix.name, 2 * (uint64_t)opt.bulk, 0, 0, [&]() {
+            for (int j = 0; j < opt.bulk; j++) index.insert(ix.rows / 2, opt.width + 1);
+            for (int j = 0; j < opt.bulk; j++) index.erase(ix.rows / 2);
+        });
+    }
+
+    std::string out = path + ".out";
+    free(b.filename);
+    b.filename = strdup(out.c_str());
+    bench(opt, "save", 1, bytes, b.numrows, [&]() {
+        if (b.editorSave() == -1) perror("save");
+    });
+
+    unlink(out.c_str());
+    unlink(path.c_str());
+}
+
+/*** main ***/
+static void usage() {
+    fprintf(stderr,
+        "usage: edi_bench [--lines N] [--width N] [--bulk N] [--filter NAME] [--json FILE]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) usage();
+        if (!strcmp(argv[i], "--lines")) opt.lines = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--width")) opt.width = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--bulk")) opt.bulk = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--filter")) opt.filter = argv[++i];
+        else if (!strcmp(argv[i], "--json")) opt.json = argv[++i];
+        else usage();
+    }
+    if (opt.lines < 1 || opt.width < 1 || opt.bulk < 1) usage();
+
+    if (!perfAllocsHooked()) fprintf(stderr, "edi_bench: built without EDI_COUNT_ALLOCS, allocs/op are not counted\n");
+    perfCountAllocs(true);
+    runAll(opt);
+
+    FILE *f = stdout;
+    if (opt.json && strcmp(opt.json, "-") != 0) f = fopen(opt.json, "w");
+    if (!f) {
+        perror("fopen");
+        return 1;
+    }
+    writeJson(opt, f);
+    if (f != stdout) fclose(f);
+    return 0;
+}
@@ -0,0 +1,360 @@
+/*** defines ***/
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
+/*** includes ***/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef __APPLE__
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+/*** defines ***/
+#define FRAME_END "\x1b[?25h\x1b[?2026l"
+#define FRAME_TIMEOUT_MS 2000
+#define QUIET_MS 50
+
+/*** options ***/
+struct LatencyOptions {
+    std::string edi;
+    int rows = 40;
+    int cols = 120;
+    int lines = 50000;
+    const char *trace = NULL;
+    const char *json = NULL;
+};
+
+/*** pty driver ***/
+struct Driver {
+    pid_t pid = -1;
+    int fd = -1;
+    std::string pending;
+};
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void writeAll(int fd, const std::string &s) {
+    size_t done = 0;
+    while (done < s.size()) {
+        ssize_t n = write(fd, s.data() + done, s.size() - done);
+        if (n == -1) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            perror("write");
+            exit(1);
+        }
+        done += n;
+    }
+}
+
+/* Reads until `frames` complete frames have arrived, then keeps reading
+ * until the terminal has been quiet for `quiet_ms` (0 = stop at once).
+ * Returns the time the last frame ended, or -1 on timeout. */
+static double readFrames(Driver &d, int frames, int quiet_ms, size_t *bytes, int *frames_seen) {
+    double last = -1;
+    int seen = 0;
+    char buf[65536];
+    *bytes = 0;
+
+    while (true) {
+        int timeout = seen < frames ? FRAME_TIMEOUT_MS : quiet_ms;
+        if (seen >= frames && quiet_ms == 0) break;
+
+        struct pollfd pfd = { d.fd, POLLIN, 0 };
+        int r = poll(&pfd, 1, timeout);
+        if (r == -1 && errno == EINTR) continue;
+        if (r <= 0) break;
+
+        ssize_t n = read(d.fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        *bytes += n;
+        d.pending.append(buf, n);
+
+        size_t pos;
+        while ((pos = d.pending.find(FRAME_END)) != std::string::npos) {
+            d.pending.erase(0, pos + strlen(FRAME_END));
+            last = now();
+            seen++;
+        }
+    }
+    *frames_seen = seen;
+    return seen >= frames ? last : -1;
+}
+
+static void startEditor(Driver &d, const LatencyOptions &opt, const std::string &home,
+                        const std::string &file) {
+    struct winsize ws;
+    memset(&ws, 0, sizeof(ws));
+    ws.ws_row = opt.rows;
+    ws.ws_col = opt.cols;
+
+    d.pid = forkpty(&d.fd, NULL, NULL, &ws);
+    if (d.pid == -1) {
+        perror("forkpty");
+        exit(1);
+    }
+    if (d.pid == 0) {
+        setenv("HOME", home.c_str(), 1);
+        setenv("TERM", "xterm-256color", 1);
+        execl(opt.edi.c_str(), opt.edi.c_str(), file.c_str(), (char *)NULL);
+        perror("execl");
+        _exit(127);
+    }
+
+    size_t bytes;
+    int seen;
+    if (readFrames(d, 1, QUIET_MS, &bytes, &seen) < 0) {
+        fprintf(stderr, "edi did not draw its first frame\n");
+        exit(1);
+    }
+}
+
+static void stopEditor(Driver &d) {
+    writeAll(d.fd, "\x11");
+    for (int i = 0; i < 100; i++) {
+        int status;
+        if (waitpid(d.pid, &status, WNOHANG) == d.pid) {
+            close(d.fd);
+            return;
+        }
+        usleep(10000);
+    }
+    kill(d.pid, SIGKILL);
+    waitpid(d.pid, NULL, 0);
+    close(d.fd);
+}
+
+/*** traces ***/
+struct Step {
+    std::string keys;
+    int frames;     /* frames the editor must draw in response */
+    bool burst;     /* keys arrive at once, frames may be merged */
+};
+
+struct Trace {
+    const char *name;
+    std::vector<Step> steps;
+};
+
+static void key(Trace &t, const std::string &k) {
+    t.steps.push_back({ k, 1, false });
+}
+
+static std::vector<Trace> buildTraces() {
+    std::vector<Trace> traces;
+
+    Trace typing = { "typing", {} };
+    const char *text = "for (int i = 0; i < count; i++) total += value[i]; /* sum */ ";
+    for (int j = 0; j < 600; j++) {
+        key(typing, std::string(1, text[j % strlen(text)]));
+        if (j % 60 == 59) key(typing, "\r");
+    }
+    traces.push_back(typing);
+
+    Trace scroll = { "scroll", {} };
+    for (int j = 0; j < 200; j++) key(scroll, "\x1b[1;5B");
+    for (int j = 0; j < 100; j++) key(scroll, "\x1b[1;5A");
+    for (int j = 0; j < 300; j++) key(scroll, "\x1b[B");
+    traces.push_back(scroll);
+
+    Trace search = { "search", {} };
+    for (int round = 0; round < 10; round++) {
+        key(search, "\x06");
+        for (const char *p = "needle"; *p; p++) key(search, std::string(1, *p));
+        for (int j = 0; j < 20; j++) key(search, "\x1b[B");
+        key(search, "\r");
+    }
+    traces.push_back(search);
+
+    Trace paste = { "paste", {} };
+    for (int round = 0; round < 5; round++) {
+        std::string block;
+        for (int j = 0; j < 40; j++) block += "pasted line of text with some words in it\r";
+        paste.steps.push_back({ block, 1, true });
+    }
+    traces.push_back(paste);
+
+    Trace save = { "save", {} };
+    for (int j = 0; j < 20; j++) {
+        key(save, "x");
+        key(save, "\x13");
+    }
+    traces.push_back(save);
+
+    return traces;
+}
+
+/*** reporting ***/
+struct TraceResult {
+    std::string name;
+    std::vector<double> latency_us;
+    uint64_t bytes;
+    int frames;
+    int timeouts;
+};
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t idx = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+static TraceResult runTrace(const LatencyOptions &opt, const Trace &trace,
+                            const std::string &home, const std::string &file) {
+    Driver d;
+    startEditor(d, opt, home, file);
+
+    TraceResult r = { trace.name, {}, 0, 0, 0 };
+    for (const Step &step : trace.steps) {
+        double start = now();
+        writeAll(d.fd, step.keys);
+
+        size_t bytes;
+        int seen;
+        double end = readFrames(d, step.frames, step.burst ? QUIET_MS : 0, &bytes, &seen);
+        r.bytes += bytes;
+        r.frames += seen;
+        if (end < 0) {
+            r.timeouts++;
+            continue;
+        }
+        r.latency_us.push_back((end - start) * 1e6);
+    }
+
+    stopEditor(d);
+    return r;
+}
+
+static void writeJson(FILE *f, const LatencyOptions &opt, const std::vector<TraceResult> &results) {
+    fprintf(f, "{\n  \"rows\": %d,\n  \"cols\": %d,\n  \"lines\": %d,\n  \"traces\": [\n",
+        opt.rows, opt.cols, opt.lines);
+    for (size_t j = 0; j < results.size(); j++) {
+        const TraceResult &r = results[j];
+        fprintf(f, "    {\"name\": \"%s\", \"samples\": %zu, \"timeouts\": %d, "
+            "\"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f, \"bytes_per_frame\": %.1f}%s\n",
+            r.name.c_str(), r.latency_us.size(), r.timeouts,
+            percentile(r.latency_us, 0.50), percentile(r.latency_us, 0.99),
+            percentile(r.latency_us, 1.0), r.frames ? (double)r.bytes / r.frames : 0.0,
+            j + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+/*** setup ***/
+static std::string makeFixture(const LatencyOptions &opt, std::string *file) {
+    char dir[] = "/tmp/edi_latency_XXXXXX";
+    if (!mkdtemp(dir)) {
+        perror("mkdtemp");
+        exit(1);
+    }
+    std::string home = dir;
+
+    std::string cfgdir = home + "/.config";
+    mkdir(cfgdir.c_str(), 0755);
+    cfgdir += "/edi";
+    mkdir(cfgdir.c_str(), 0755);
+    FILE *f = fopen((cfgdir + "/config.conf").c_str(), "w");
+    fprintf(f, "tab_stop=4\nquit_times=0\njournal=0\n");
+    fclose(f);
+
+    *file = home + "/corpus.c";
+    f = fopen(file->c_str(), "w");
+    for (int j = 0; j < opt.lines; j++) {
+        if (j % 50 == 0) fprintf(f, "/* section %d: find the needle here */\n", j);
+        fprintf(f, "\tint value_%d = %d; // line %d of the corpus\n", j, j * 7, j);
+    }
+    fclose(f);
+    return home;
+}
+
+static void cleanup(const std::string &home) {
+    std::string cmd = "rm -rf '" + home + "'";
+    if (system(cmd.c_str()) != 0) fprintf(stderr, "could not remove %s\n", home.c_str());
+}
+
+/*** main ***/
+static void usage() {
+    fprintf(stderr, "usage: edi_latency [--edi PATH] [--rows N] [--cols N] [--lines N] "
+        "[--trace typing|scroll|search|paste|save] [--json FILE]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    LatencyOptions opt;
+
+    char self[PATH_MAX];
+    ssize_t n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (n > 0) {
+        self[n] = '\0';
+        opt.edi = std::string(self, strrchr(self, '/') - self) + "/edi";
+    } else {
+        opt.edi = "./edi";
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) usage();
+        if (!strcmp(argv[i], "--edi")) opt.edi = argv[++i];
+        else if (!strcmp(argv[i], "--rows")) opt.rows = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cols")) opt.cols = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--lines")) opt.lines = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--trace")) opt.trace = argv[++i];
+        else if (!strcmp(argv[i], "--json")) opt.json = argv[++i];
+        else usage();
+    }
+    if (opt.rows < 3 || opt.cols < 10 || opt.lines < 1) usage();
+    if (access(opt.edi.c_str(), X_OK) == -1) {
+        fprintf(stderr, "edi binary not found: %s (use --edi)\n", opt.edi.c_str());
+        return 1;
+    }
+
+    std::vector<TraceResult> results;
+    for (const Trace &trace : buildTraces()) {
+        if (opt.trace && strcmp(opt.trace, trace.name)) continue;
+
+        std::string file;
+        std::string home = makeFixture(opt, &file);
+        TraceResult r = runTrace(opt, trace, home, file);
+        cleanup(home);
+
+        fprintf(stderr, "%-8s %6zu samples  p50 %9.1f us  p99 %9.1f us  max %9.1f us  %8.1f bytes/frame%s\n",
+            r.name.c_str(), r.latency_us.size(), percentile(r.latency_us, 0.50),
+            percentile(r.latency_us, 0.99), percentile(r.latency_us, 1.0),
+            r.frames ? (double)r.bytes / r.frames : 0.0,
+            r.timeouts ? "  (timeouts!)" : "");
+        results.push_back(r);
+    }
+
+    FILE *f = stdout;
+    if (opt.json && strcmp(opt.json, "-") != 0) f = fopen(opt.json, "w");
+    if (!f) {
+        perror("fopen");
+        return 1;
+    }
+    writeJson(f, opt, results);
+    if (f != stdout) fclose(f);
+
+    for (const TraceResult &r : results) if (r.timeouts) return 1;
+    return 0;
+}
@@ -0,0 +1,299 @@
+/*** defines ***/
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
+/*** includes ***/
+#include "include/batch.hpp"
+#include "include/buffer.hpp"
+#include "include/config.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/*** parsing ***/
+static std::string unescape(const char *s) {
+    std::string out;
+    for (; *s; s++) {
+        if (*s != '\\' || !s[1]) {
+            out += *s;
+            continue;
+        }
+        s++;
+        switch (*s) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            default: out += *s; break;
+        }
+    }
+    return out;
+}
+
+int Batch::load(const char *path) {
+    script = path;
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "edi: %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    int lineno = 0;
+    int ret = 0;
+    while ((len = getline(&line, &cap, f)) != -1) {
+        lineno++;
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) line[--len] = '\0';
+        if (parse(line, lineno) == -1) {
+            ret = -1;
+            break;
+        }
+    }
+    free(line);
+    fclose(f);
+    return ret;
+}
+
+int Batch::parse(const char *line, int lineno) {
+    while (*line == ' ' || *line == '\t') line++;
+    if (*line == '\0' || *line == '#') return 0;
+
+    static const struct { const char *name; int op; } names[] = {
+        { "goto", BT_GOTO }, { "offset", BT_OFFSET }, { "top", BT_TOP }, { "bottom", BT_BOTTOM },
+        { "up", BT_UP }, { "down", BT_DOWN }, { "left", BT_LEFT }, { "right", BT_RIGHT },
+        { "home", BT_HOME }, { "end", BT_END }, { "find", BT_FIND },
+        { "insert", BT_INSERT }, { "newline", BT_NEWLINE }, { "delete", BT_DELETE },
+        { "delete-line", BT_DELETE_LINE }, { "replace", BT_REPLACE }, { "save", BT_SAVE }
+    };
+
+    size_t wlen = strcspn(line, " \t");
+    const char *arg = line + wlen;
+    if (*arg) arg++;
+
+    BatchCommand cmd = { 0, 1, 0, "", "" };
+    for (auto &n : names) {
+        if (strlen(n.name) == wlen && !strncmp(line, n.name, wlen)) cmd.op = n.op;
+    }
+
+    switch (cmd.op) {
+        case BT_GOTO:
+        case BT_UP:
+        case BT_DOWN:
+        case BT_LEFT:
+        case BT_RIGHT:
+        case BT_DELETE:
+        case BT_DELETE_LINE:
+            if (*arg) cmd.count = atoi(arg);
+            if (cmd.count < 1) cmd.op = -1;
+            break;
+
+        case BT_OFFSET:
+            if (Buffer::parseOffset(arg, &cmd.offset) == -1) cmd.op = -1;
+            break;
+
+        case BT_FIND:
+        case BT_INSERT:
+            cmd.text = unescape(arg);
+            if (cmd.text.empty()) cmd.op = -1;
+            break;
+
+        case BT_REPLACE:
+        {
+            /* replace /old/new/ with any delimiter, sed style */
+            char delim = *arg;
+            const char *from = delim ? arg + 1 : arg;
+            const char *mid = delim ? strchr(from, delim) : NULL;
+            if (!mid || mid == from) {
+                cmd.op = -1;
+                break;
+            }
+            cmd.text = unescape(std::string(from, mid - from).c_str());
+            const char *end = strchr(mid + 1, delim);
+            std::string with = end ? std::string(mid + 1, end - mid - 1) : std::string(mid + 1);
+            cmd.with = unescape(with.c_str());
+            if (cmd.text.find('\n') != std::string::npos ||
+                cmd.with.find('\n') != std::string::npos) cmd.op = -1;
+            break;
+        }
+    }
+
+    if (cmd.op <= 0) {
+        fprintf(stderr, "edi: %s:%d: bad command: %s\n", script.c_str(), lineno, line);
+        return -1;
+    }
+    commands.push_back(cmd);
+    return 0;
+}
+
+/*** editing ***/
+static void clampCursor(Buffer &b) {
+    if (b.cursor_y > b.numrows) b.cursor_y = b.numrows;
+    if (b.cursor_y < 0) b.cursor_y = 0;
+    int len = b.cursor_y < b.numrows ? b.rows[b.cursor_y].size : 0;
+    if (b.cursor_x > len) b.cursor_x = len;
+    if (b.cursor_x < 0) b.cursor_x = 0;
+}
+
+/* From the cursor, or just past it when the cursor sits on the previous
+ * match, so repeating a find moves on to the next one. */
+static bool findText(Buffer &b, const std::string &text, bool again) {
+    for (int y = b.cursor_y; y < b.numrows; y++) {
+        std::string line(b.editorRowText(&b.rows[y]), b.rows[y].size);
+        size_t pos = line.find(text, y == b.cursor_y ? b.cursor_x + again : 0);
+        if (pos != std::string::npos) {
+            b.cursor_y = y;
+            b.cursor_x = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void replaceAll(Buffer &b, const std::string &from, const std::string &to) {
+    for (int y = 0; y < b.numrows; y++) {
+        trow_ *row = &b.rows[y];
+        const char *text = b.editorRowText(row);
+        if (!memmem(text, row->size, from.data(), from.size())) continue;
+
+        std::string line(text, row->size);
+        size_t pos = 0;
+        while ((pos = line.find(from, pos)) != std::string::npos) {
+            line.replace(pos, from.size(), to);
+            pos += to.size();
+        }
+        b.editorRowSetText(row, line.data(), line.size());
+    }
+}
+
+int Batch::apply(const char *file, BulkIO &io, std::string &err) {
+    Buffer b;
+    b.highlight = false;
+    b.io = &io;
+    if (b.editorOpen(file) == -1) {
+        err = strerror(errno);
+        return FILE_FAILED;
+    }
+
+    int result = FILE_UNCHANGED;
+    bool matched = false;
+    for (const BatchCommand &cmd : commands) {
+        switch (cmd.op) {
+            case BT_GOTO:
+                b.cursor_y = cmd.count - 1;
+                b.cursor_x = 0;
+                break;
+            case BT_OFFSET:
+                b.editorGotoOffset(cmd.offset);
+                break;
+            case BT_TOP:
+                b.cursor_y = b.cursor_x = 0;
+                break;
+            case BT_BOTTOM:
+                b.cursor_y = b.numrows;
+                b.cursor_x = 0;
+                break;
+            case BT_UP: b.cursor_y -= cmd.count; break;
+            case BT_DOWN: b.cursor_y += cmd.count; break;
+            case BT_LEFT: b.cursor_x -= cmd.count; break;
+            case BT_RIGHT: b.cursor_x += cmd.count; break;
+            case BT_HOME: b.cursor_x = 0; break;
+            case BT_END: b.cursor_x = INT32_MAX; break;
+
+            case BT_FIND:
+                /* The rest of the script is skipped; an earlier save stands. */
+                if (!findText(b, cmd.text, matched)) return result == FILE_SAVED ? FILE_SAVED : FILE_SKIPPED;
+                break;
+
+            case BT_INSERT:
+                for (char c : cmd.text) {
+                    if (c == '\n') b.editorInsertNewLine();
+                    else b.editorInsertChar(c);
+                }
+                break;
+
+            case BT_NEWLINE:
+                b.editorInsertNewLine();
+                break;
+
+            case BT_DELETE:
+                for (int j = 0; j < cmd.count && b.cursor_y < b.numrows; j++) {
+                    if (b.cursor_x < b.rows[b.cursor_y].size) {
+                        b.editorRowDeleteChar(&b.rows[b.cursor_y], b.cursor_x);
+                    } else if (b.cursor_y + 1 < b.numrows) {
+                        int x = b.cursor_x;
+                        b.cursor_y++;
+                        b.cursor_x = 0;
+                        b.editorDelChar();
+                        b.cursor_x = x;
+                    }
+                }
+                break;
+
+            case BT_DELETE_LINE:
+                for (int j = 0; j < cmd.count && b.cursor_y < b.numrows; j++) {
+                    b.editorDelRow(b.cursor_y);
+                }
+                break;
+
+            case BT_REPLACE:
+                replaceAll(b, cmd.text, cmd.with);
+                break;
+
+            case BT_SAVE:
+                if (!b.dirty) break;
+                if (b.editorSave() == -1) {
+                    err = strerror(errno);
+                    return FILE_FAILED;
+                }
+                result = FILE_SAVED;
+                break;
+        }
+        clampCursor(b);
+        matched = cmd.op == BT_FIND;
+    }
+    return result;
+}
+
+/*** driver ***/
+int Batch::run(int nfiles, char **files) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    std::atomic<int> next(0);
+    std::atomic<int> counts[4];
+    for (auto &c : counts) c = 0;
+
+    auto worker = [&]() {
+        BulkIO io(cfg.config.io_uring);
+        int j;
+        while ((j = next++) < nfiles) {
+            std::string err;
+            int r = apply(files[j], io, err);
+            if (r == FILE_FAILED) fprintf(stderr, "edi: %s: %s\n", files[j], err.c_str());
+            counts[r]++;
+        }
+    };
+
+    unsigned int nthreads = std::max(1u, std::thread::hardware_concurrency());
+    nthreads = std::min<unsigned int>(nthreads, nfiles);
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < nthreads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool) t.join();
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "edi: %d files: %d saved, %d unchanged, %d skipped, %d failed "
+        "in %.3f s (%.0f files/s, %u threads)\n",
+        nfiles, counts[FILE_SAVED].load(), counts[FILE_UNCHANGED].load(),
+        counts[FILE_SKIPPED].load(), counts[FILE_FAILED].load(),
+        seconds, seconds > 0 ? nfiles / seconds : 0.0, nthreads);
+
+    return counts[FILE_FAILED] ? 1 : 0;
+}
@@ -0,0 +1,1286 @@
+/*** defines ***/
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
+/*** includes ***/
+#include "include/buffer.hpp"
+#include "include/config.hpp"
+#include "include/bulkio.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <algorithm>
+#include <memory>
+
+/*** init ***/
+Config cfg;
+
+Buffer::Buffer()
+    : cursor_x(0), cursor_y(0), mark_y(-1), row_offset(0), col_offset(0), numrows(0),
+      rows(NULL), filename(NULL), dirty(0), syntax(NULL), stamp(), highlight(true),
+      io(NULL), wrap_width(0), recovered(0), journal_busy(false), next_edit_site(0) {
+    for (int &site : edit_sites) site = -1;
+}
+
+Buffer::~Buffer() {
+    editorClose();
+}
+
+void Buffer::editorClose() {
+    for (int j = 0; j < numrows; j++) editorFreeRow(&rows[j]);
+    free(rows);
+    free(filename);
+
+    cursor_x = cursor_y = 0;
+    mark_y = -1;
+    row_offset = col_offset = 0;
+    numrows = 0;
+    rows = NULL;
+    filename = NULL;
+    dirty = 0;
+    syntax = NULL;
+    offsets.clear();
+    recovered = 0;
+    journal_busy = false;
+    cold.clear();
+    wraps.clear();
+    lengths.clear();
+    diff.stop();
+    for (int &site : edit_sites) site = -1;
+}
+
+/*** rows ***/
+void Buffer::editorInsertRow(int at, const char *s, size_t len) {
+    if (at < 0 || at > numrows) return;
+
+    rows = (trow_*)realloc(rows, sizeof(trow_) * (numrows + 1));
+    memmove(&rows[at + 1], &rows[at], sizeof(trow_) * (numrows - at));
+    for (int j = at + 1; j <= numrows; j++) rows[j].idx++;
+
+    rows[at].idx = at;
+
+    rows[at].size = len;
+    rows[at].chars = (char*)malloc(len + 1);
+    memcpy(rows[at].chars, s, len);
+    rows[at].chars[len] = '\0';
+
+    rows[at].r_size = 0;
+    rows[at].width = 0;
+    rows[at].ascii = true;
+    rows[at].render = NULL;
+    rows[at].hl = NULL;
+    rows[at].cols = NULL;
+    /* The row below was lexed after rows[at - 1]; start from that state so
+     * the syntax pass can tell when it has caught up. */
+    rows[at].hl_open_comment = at > 0 && rows[at - 1].hl_open_comment;
+    rows[at].atom = NULL;
+    rows[at].block = NULL;
+    rows[at].slot = 0;
+    if (wrap_width) wraps.insert(at, 1);
+    lengths.insert(at, len + 1);
+    if (diff.active()) diff.rowInserted(at);
+    numrows++;
+    dirty++;
+    /* Counted first, so the syntax pass reaches a row appended at the end
+     * and the rows after a changed comment state down to the last one. */
+    editorUpdateRow(&rows[at]);
+    journal.record(JR_INSERT_ROW, at, 0, s, len);
+    editorNoteEdit(at);
+}
+
+/* Inserts a row sharing the atom's storage; the caller passes a reference.
+ * Highlighting is left to the caller, which usually does it in bulk. */
+void Buffer::editorInsertAtom(int at, LineAtom *atom) {
+    if (at < 0 || at > numrows) return;
+
+    rows = (trow_*)realloc(rows, sizeof(trow_) * (numrows + 1));
+    memmove(&rows[at + 1], &rows[at], sizeof(trow_) * (numrows - at));
+    for (int j = at + 1; j <= numrows; j++) rows[j].idx++;
+
+    trow_ *row = &rows[at];
+    row->idx = at;
+    row->size = atom->size;
+    row->chars = atom->chars;
+    row->render = NULL;
+    row->hl = NULL;
+    row->cols = NULL;
+    row->hl_open_comment = 0;
+    row->atom = atom;
+    row->block = NULL;
+    row->slot = 0;
+    if (wrap_width) wraps.insert(at, 1);
+    lengths.insert(at, atom->size + 1);
+    if (diff.active()) diff.rowInserted(at);
+    editorUpdateRender(row);
+    journal.record(JR_INSERT_ROW, at, 0, atom->chars, atom->size);
+
+    numrows++;
+    dirty++;
+}
+
+/* Copy-on-write: gives the row private copies before it is modified. */
+void Buffer::editorRowUnshare(trow_ *row) {
+    LineAtom *atom = row->atom;
+    if (!atom) return;
+
+    row->chars = (char *)malloc(row->size + 1);
+    memcpy(row->chars, atom->chars, row->size + 1);
+    if (row->render && row->render == atom->render) {
+        row->render = (char *)malloc(row->r_size + 1);
+        memcpy(row->render, atom->render, row->r_size + 1);
+    }
+    editorRowOwnHl(row);
+    row->atom = NULL;
+    lines.release(atom);
+}
+
+unsigned char *Buffer::editorRowOwnHl(trow_ *row) {
+    if (row->atom && row->hl && row->hl == row->atom->hl.load()) {
+        unsigned char *hl = (unsigned char *)malloc(row->r_size + 1);
+        memcpy(hl, row->hl, row->r_size + 1);
+        row->hl = hl;
+    }
+    return row->hl;
+}
+
+void Buffer::editorUpdateRow(trow_ *row) {
+    lengths.set(row->idx, row->size + 1);
+    if (diff.active()) diff.rowChanged(row->idx);
+    editorUpdateRender(row);
+    editorUpdateSyntax(row);
+}
+
+/* Tab stops are counted in display columns, so rows holding UTF-8 are
+ * measured codepoint by codepoint; all-ASCII rows keep the byte loop. */
+static char *renderLine(const char *chars, int size, int *r_size, int *width, bool *ascii) {
+    int tabs = 0;
+    int j;
+    for (j = 0; j < size; j++) if (chars[j] == '\t') tabs++;
+
+    char *render = (char*)malloc(size + (tabs * (cfg.config.tab_stop - 1)) + 1);
+    *ascii = utf8IsAscii(chars, size);
+
+    int idx = 0;
+    int col = 0;
+    for (int j = 0; j < size;) {
+        if (chars[j] == '\t') {
+            render[idx++] = ' ';
+            col++;
+            while (col % cfg.config.tab_stop != 0) {
+                render[idx++] = ' ';
+                col++;
+            }
+            j++;
+        } else if (*ascii) {
+            render[idx++] = chars[j++];
+            col++;
+        } else {
+            uint32_t cp;
+            int n = utf8Decode(&chars[j], size - j, &cp);
+            int w = utf8Width(cp);
+            memcpy(&render[idx], &chars[j], n);
+            idx += n;
+            j += n;
+            col += w < 0 ? 1 : w;
+        }
+    }
+    render[idx] = '\0';
+    *r_size = idx;
+    *width = col;
+    return render;
+}
+
+void Buffer::editorUpdateRender(trow_ *row) {
+    editorRowTouch(row);
+    LineAtom *atom = row->atom;
+    if (atom) {
+        if (!atom->render) atom->render = renderLine(atom->chars, atom->size, &atom->r_size, &atom->width, &atom->ascii);
+        if (row->render != atom->render) free(row->render);
+        row->render = atom->render;
+        row->r_size = atom->r_size;
+        row->width = atom->width;
+        row->ascii = atom->ascii;
+    } else {
+        free(row->render);
+        row->render = renderLine(row->chars, row->size, &row->r_size, &row->width, &row->ascii);
+    }
+    free(row->cols);
+    row->cols = NULL;
+    if (wrap_width) wraps.set(row->idx, editorRowWrapCount(row));
+}
+
+void Buffer::editorRowPrepare(trow_ *row) {
+    if (row->render && row->hl) return;
+    if (!row->render) editorUpdateRender(row);
+    editorHighlightRow(row, row->idx > 0 && rows[row->idx - 1].hl_open_comment);
+}
+
+/* Highlights a row that has a render. Of a row without one, cold or
+ * trimmed, only the comment state it leaves is lexed, in a scratch render;
+ * the row stays as it is until it is drawn. */
+int Buffer::editorRowLexState(trow_ *row, int in_comment) {
+    if (row->render) return editorHighlightRow(row, in_comment);
+
+    trow_ scratch = *row;
+    scratch.render = renderLine(editorRowText(row), row->size, &scratch.r_size, &scratch.width, &scratch.ascii);
+    unsigned char *hl = (unsigned char *)malloc(scratch.r_size + 1);
+    int out = editorLexRow(&scratch, hl, in_comment);
+    free(hl);
+    free(scratch.render);
+    return out;
+}
+
+int Buffer::editorOpen(const char *filename) {
+    free(this->filename);
+    this->filename = strdup(filename);
+
+    if (cfg.config.session_cache && !dataDir.empty() && editorOpenSession(filename) == 0) {
+        if (wrap_width) editorSetWrap(wrap_width);
+        editorOpenJournal();
+        return 0;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) return -1;
+
+    /* Lines are split out of each chunk while the following ones are still
+     * being read; only a line crossing a chunk boundary is copied. */
+    uint64_t offset = 0;
+    auto addLine = [&](const char *line, size_t lineLen) {
+        offsets.push_back(offset);
+        offset += lineLen;
+        while (lineLen > 0 && (line[lineLen - 1] == '\n' ||
+                               line[lineLen - 1] == '\r')) {
+            lineLen--;
+        }
+        if (cfg.config.intern_lines) editorInsertAtom(numrows, lines.intern(line, lineLen));
+        else editorInsertRow(numrows, line, lineLen);
+    };
+
+    std::unique_ptr<BulkIO> own;
+    if (!io) own.reset(new BulkIO(cfg.config.io_uring));
+    BulkIO &bio = io ? *io : *own;
+    std::string carry;
+    const char *data;
+    ssize_t n = bio.startRead(fd);
+    while (n != -1 && (n = bio.next(&data)) > 0) {
+        const char *p = data, *end = data + n;
+        while (p < end) {
+            const char *nl = (const char *)memchr(p, '\n', end - p);
+            if (!nl) {
+                carry.append(p, end - p);
+                break;
+            }
+            if (carry.empty()) {
+                addLine(p, nl + 1 - p);
+            } else {
+                carry.append(p, nl + 1 - p);
+                addLine(carry.data(), carry.size());
+                carry.clear();
+            }
+            p = nl + 1;
+        }
+    }
+    if (n == -1) {
+        int saved_errno = errno;
+        close(fd);
+        while (numrows > 0) editorDelRow(numrows - 1);
+        offsets.clear();
+        errno = saved_errno;
+        return -1;
+    }
+    if (!carry.empty()) addLine(carry.data(), carry.size());
+    close(fd);
+    fileStamp(filename, &stamp);
+
+    editorSelectSyntaxHighlight();
+    dirty = 0;
+    for (int &site : edit_sites) site = -1;
+    editorOpenJournal();
+    return 0;
+}
+
+int Buffer::editorOpenSession(const char *filename) {
+    /* Only taken on success: a failed load falls back to editorOpen's own
+     * read, which selects the syntax itself. */
+    struct editorSyntax *found = editorFindSyntax();
+
+    Session session;
+    if (session.load(dataDir + "/sessions", filename,
+            found ? found->filetype : NULL, cfg.config.tab_stop) == -1) return -1;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) return -1;
+
+    size_t size = session.header->stamp.size;
+    char *data = NULL;
+    if (size) {
+        data = (char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+    }
+    close(fd);
+
+    int n = session.header->numrows;
+    rows = (trow_*)malloc(sizeof(trow_) * n);
+    offsets.assign(session.offsets, session.offsets + n);
+    std::vector<int64_t> sizes(n);
+    for (int j = 0; j < n; j++) {
+        trow_ *row = &rows[j];
+        row->idx = j;
+        row->size = session.lengths[j];
+        sizes[j] = row->size + 1;
+        row->atom = NULL;
+        row->block = NULL;
+        row->slot = 0;
+        if (cfg.config.intern_lines) {
+            row->atom = lines.intern(data + session.offsets[j], row->size);
+            row->chars = row->atom->chars;
+        } else {
+            row->chars = (char*)malloc(row->size + 1);
+            memcpy(row->chars, data + session.offsets[j], row->size);
+            row->chars[row->size] = '\0';
+        }
+
+        /* render and hl are built on first use from the cached lexer state;
+         * until then the render length stands in as the width */
+        row->r_size = session.r_sizes[j];
+        row->width = row->r_size;
+        row->ascii = true;
+        row->render = NULL;
+        row->hl = NULL;
+        row->cols = NULL;
+        row->hl_open_comment = session.open_comment[j];
+    }
+    numrows = n;
+    lengths.assign(std::move(sizes));
+    if (data) munmap(data, size);
+    syntax = found;
+
+    stamp = session.header->stamp;
+    cursor_y = std::min<int>(std::max(session.header->cursor_y, 0), numrows);
+    cursor_x = cursor_y < numrows ?
+        std::min<int>(std::max(session.header->cursor_x, 0), rows[cursor_y].size) : 0;
+    row_offset = std::min<int>(std::max(session.header->row_offset, 0), cursor_y);
+    col_offset = std::max(session.header->col_offset, 0);
+    dirty = 0;
+    return 0;
+}
+
+void Buffer::editorStoreSession() {
+    if (!cfg.config.session_cache || dataDir.empty() || !filename || dirty) return;
+    if ((int)offsets.size() != numrows) return;
+
+    FileStamp now;
+    if (fileStamp(filename, &now) == -1 || !fileStampEqual(now, stamp)) return;
+
+    std::vector<uint32_t> lengths(numrows), r_sizes(numrows);
+    std::vector<uint8_t> open_comment(numrows);
+    for (int j = 0; j < numrows; j++) {
+        lengths[j] = rows[j].size;
+        r_sizes[j] = rows[j].r_size;
+        open_comment[j] = rows[j].hl_open_comment;
+    }
+
+    SessionState state;
+    state.tab_stop = cfg.config.tab_stop;
+    state.cursor_x = cursor_x;
+    state.cursor_y = cursor_y;
+    state.row_offset = row_offset;
+    state.col_offset = col_offset;
+
+    Session::store(dataDir + "/sessions", filename,
+        syntax ? syntax->filetype : NULL, state, offsets, lengths, r_sizes, open_comment);
+}
+
+void Buffer::editorOpenJournal() {
+    if (!cfg.config.journal || dataDir.empty() || !filename) return;
+
+    int replayed = journal.open(dataDir + "/journal", filename, stamp,
+        [this](const JournalRecord &rec, const char *s) { this->editorJournalReplay(rec, s); });
+    if (replayed > 0) recovered = replayed;
+    if (replayed == -1 && errno == EBUSY) journal_busy = true;
+}
+
+void Buffer::editorJournalReplay(const JournalRecord &rec, const char *s) {
+    bool has_row = rec.row >= 0 && rec.row < numrows;
+    trow_ *row = has_row ? &rows[rec.row] : NULL;
+
+    switch (rec.op) {
+        case JR_INSERT_CHAR:
+            if (row && rec.len == 1) editorRowInsertChar(row, rec.at, s[0]);
+            break;
+        case JR_DELETE_CHAR:
+            if (row) editorRowDeleteChar(row, rec.at);
+            break;
+        case JR_INSERT_ROW:
+            editorInsertRow(rec.row, s, rec.len);
+            break;
+        case JR_DELETE_ROW:
+            editorDelRow(rec.row);
+            break;
+        case JR_APPEND_STRING:
+            if (row) editorRowAppendString(row, s, rec.len);
+            break;
+        case JR_SET_ROW:
+            if (row) editorRowSetText(row, s, rec.len);
+            break;
+        case JR_TRUNCATE_ROW:
+            if (row && rec.at >= 0 && rec.at <= row->size) {
+                editorRowUnshare(row);
+                row->size = rec.at;
+                row->chars[row->size] = '\0';
+                editorUpdateRow(row);
+            }
+            break;
+    }
+}
+
+int Buffer::editorRowCxToRx(trow_ *row, int cx) {
+    editorRowTouch(row);
+    if (!row->render) editorUpdateRender(row);
+    if (!row->ascii) return editorRowCols(row)[std::min(std::max(cx, 0), row->size)];
+    int rx = 0;
+    int j;
+    for (j = 0; j < cx; j++) {
+        if (row->chars[j] == '\t') rx += (cfg.config.tab_stop - 1) - (rx % cfg.config.tab_stop);
+        rx++;
+    }
+    return rx;
+}
+
+int Buffer::editorRowRxToCx(trow_ *row, int rx) {
+    editorRowTouch(row);
+    if (!row->render) editorUpdateRender(row);
+    if (!row->ascii) {
+        int *col = editorRowCols(row);
+        if (rx >= col[row->size]) return row->size;
+        int cx = std::upper_bound(col, col + row->size + 1, rx) - col - 1;
+        return editorRowCharStart(row, std::max(cx, 0));
+    }
+    int cur_rx = 0;
+    int cx;
+    for (cx = 0; cx < row->size; cx++) {
+        if (row->chars[cx] == '\t') cur_rx += (cfg.config.tab_stop - 1) - (cur_rx % cfg.config.tab_stop);
+        cur_rx++;
+
+        if (cur_rx > rx) return cx;
+    }
+    return cx;
+}
+
+/* Character index of a byte offset into render, as strstr reports it. */
+int Buffer::editorRowRenderToCx(trow_ *row, int at) {
+    editorRowTouch(row);
+    if (!row->render) editorUpdateRender(row);
+    if (row->ascii) return editorRowRxToCx(row, at);
+    int *rb = editorRowCols(row) + row->size + 1;
+    return std::lower_bound(rb, rb + row->size + 1, at) - rb;
+}
+
+int Buffer::editorRowNextChar(trow_ *row, int cx) {
+    editorRowTouch(row);
+    if (cx >= row->size) return row->size;
+    uint32_t cp;
+    return cx + utf8Decode(&row->chars[cx], row->size - cx, &cp);
+}
+
+int Buffer::editorRowPrevChar(trow_ *row, int cx) {
+    if (cx <= 0) return 0;
+    return editorRowCharStart(row, cx - 1);
+}
+
+/* The first byte of the character covering cx; a stray continuation byte
+ * is a character of its own. */
+int Buffer::editorRowCharStart(trow_ *row, int cx) {
+    editorRowTouch(row);
+    if (cx <= 0 || cx >= row->size || !utf8IsCont(row->chars[cx])) return cx;
+    int start = cx;
+    while (start > 0 && cx - start < 3 && utf8IsCont(row->chars[start])) start--;
+    uint32_t cp;
+    int n = utf8Decode(&row->chars[start], row->size - start, &cp);
+    return start + n > cx ? start : cx;
+}
+
+/* Column and render offset of every byte of a non-ASCII row, built on
+ * first use and kept until its render is rebuilt or dropped. */
+int *Buffer::editorRowCols(trow_ *row) {
+    if (row->cols) return row->cols;
+    int *col = (int*)malloc(sizeof(int) * 2 * (row->size + 1));
+    int *rb = col + row->size + 1;
+    int c = 0, b = 0;
+    for (int j = 0; j < row->size;) {
+        if (row->chars[j] == '\t') {
+            int stop = (c / cfg.config.tab_stop + 1) * cfg.config.tab_stop;
+            col[j] = c;
+            rb[j] = b;
+            b += stop - c;
+            c = stop;
+            j++;
+            continue;
+        }
+        uint32_t cp;
+        int n = utf8Decode(&row->chars[j], row->size - j, &cp);
+        int w = utf8Width(cp);
+        for (int k = 0; k < n; k++) {
+            col[j + k] = c;
+            rb[j + k] = b + k;
+        }
+        c += w < 0 ? 1 : w;
+        b += n;
+        j += n;
+    }
+    col[row->size] = c;
+    rb[row->size] = b;
+    row->cols = col;
+    return col;
+}
+
+void Buffer::editorRowInsertChar(trow_ *row, int at, int c) {
+    if (at < 0 || at > row->size) at = row->size;
+    editorRowTouch(row);
+    editorRowUnshare(row);
+    row->chars = (char*)realloc(row->chars, row->size + 2);
+    memmove(&row->chars[at + 1], &row->chars[at], row->size - at + 1);
+    row->size++;
+    row->chars[at] = c;
+    editorUpdateRow(row);
+    dirty++;
+
+    char ch = c;
+    journal.record(JR_INSERT_CHAR, row->idx, at, &ch, 1);
+    editorNoteEdit(row->idx);
+}
+
+void Buffer::editorInsertChar(int c) {
+    if (cursor_y == numrows) editorInsertRow(numrows, "", 0);
+    editorRowInsertChar(&rows[cursor_y], cursor_x, c);
+    cursor_x++;
+}
+
+/* Serializes rows straight into the I/O chunks, so one chunk is filled
+ * while the ones before it are still being written. */
+int Buffer::editorWriteRows(int fd) {
+    std::unique_ptr<BulkIO> own;
+    if (!io) own.reset(new BulkIO(cfg.config.io_uring));
+    BulkIO &bio = io ? *io : *own;
+    bio.startWrite(fd, lengths.total());
+    char *buf = bio.buffer();
+    size_t used = 0;
+    auto emit = [&](const char *s, size_t len) {
+        while (len > 0) {
+            if (used == BULKIO_CHUNK) {
+                if (bio.put(used) == -1) return false;
+                buf = bio.buffer();
+                used = 0;
+            }
+            size_t n = std::min(len, (size_t)BULKIO_CHUNK - used);
+            memcpy(buf + used, s, n);
+            used += n;
+            s += n;
+            len -= n;
+        }
+        return true;
+    };
+
+    bool ok = true;
+    for (int j = 0; j < numrows && ok; j++) ok = emit(editorRowText(&rows[j]), rows[j].size) && emit("\n", 1);
+    if (ok && used > 0) ok = bio.put(used) == 0;
+    int saved_errno = errno;
+    if (bio.finish() == -1) return -1;
+    errno = saved_errno;
+    return ok ? 0 : -1;
+}
+
+int64_t Buffer::editorSave() {
+    if (filename == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    int64_t len = lengths.total();
+
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd != -1) {
+        if (ftruncate(fd, len) != -1) {
+            if (editorWriteRows(fd) == 0) {
+                close(fd);
+
+                offsets.resize(numrows);
+                uint64_t offset = 0;
+                for (int j = 0; j < numrows; j++) {
+                    offsets[j] = offset;
+                    offset += rows[j].size + 1;
+                }
+                fileStamp(filename, &stamp);
+                dirty = 0;
+                if (diff.active()) {
+                    std::vector<uint64_t> hashes(numrows);
+                    for (int j = 0; j < numrows; j++) hashes[j] = editorRowHash(j);
+                    diff.rebase(hashes);
+                }
+                if (journal.active()) journal.reset(stamp);
+                else editorOpenJournal();
+
+                return len;
+            }
+        }
+        int saved_errno = errno;
+        close(fd);
+        errno = saved_errno;
+    }
+    return -1;
+}
+
+void Buffer::editorRowDeleteChar(trow_ *row, int at) {
+    if (at < 0 || at >= row->size) return;
+    editorRowTouch(row);
+    editorRowUnshare(row);
+    memmove(&row->chars[at], &row->chars[at+1], row->size - at);
+    row->size--;
+    editorUpdateRow(row);
+    dirty++;
+    journal.record(JR_DELETE_CHAR, row->idx, at, NULL, 0);
+    editorNoteEdit(row->idx);
+}
+
+void Buffer::editorDelChar() {
+    if (cursor_y == numrows) return;
+    if (cursor_x == 0 && cursor_y == 0) return;
+
+    trow_ *row = &rows[cursor_y];
+    if (cursor_x > 0) {
+        int from = editorRowPrevChar(row, cursor_x);
+        while (cursor_x > from) editorRowDeleteChar(row, --cursor_x);
+    } else {
+        editorRowTouch(row);
+        cursor_x = rows[cursor_y - 1].size;
+        editorRowAppendString(&rows[cursor_y - 1], row->chars, row->size);
+        editorDelRow(cursor_y);
+        cursor_y--;
+    }
+}
+
+void Buffer::editorFreeRow(trow_ *row) {
+    if (!row->chars) {
+        cold.drop(row->block);
+        return;
+    }
+    LineAtom *atom = row->atom;
+    if (atom) {
+        if (row->render != atom->render) free(row->render);
+        if (row->hl != atom->hl.load()) free(row->hl);
+        free(row->cols);
+        lines.release(atom);
+        return;
+    }
+    free(row->render);
+    free(row->chars);
+    free(row->hl);
+    free(row->cols);
+}
+
+void Buffer::editorDelRow(int at) {
+    if (at < 0 || at >= numrows) return;
+    editorFreeRow(&rows[at]);
+    memmove(&rows[at], &rows[at + 1], sizeof(trow_) * (numrows - at - 1));
+    for (int j = at; j < numrows - 1; j++) rows[j].idx--;
+    if (wrap_width) wraps.erase(at);
+    lengths.erase(at);
+    if (diff.active()) diff.rowDeleted(at);
+    numrows--;
+    dirty++;
+    journal.record(JR_DELETE_ROW, at, 0, NULL, 0);
+    editorNoteEdit(at);
+    if (at < numrows) editorUpdateSyntaxRange(at, at - 1);
+}
+
+void Buffer::editorRowAppendString(trow_ *row, const char *s, size_t len) {
+    editorRowTouch(row);
+    editorRowUnshare(row);
+    row->chars = (char *)realloc(row->chars, row->size + len + 1);
+    memcpy(&row->chars[row->size], s, len);
+    row->size += len;
+    row->chars[row->size] = '\0';
+    editorUpdateRow(row);
+    dirty++;
+    journal.record(JR_APPEND_STRING, row->idx, 0, s, len);
+    editorNoteEdit(row->idx);
+}
+
+/* Replaces the whole text of a row in place: one journal record, no shift
+ * of the row array. A cold row is dropped rather than thawed. */
+void Buffer::editorRowSetText(trow_ *row, const char *s, size_t len) {
+    if (!row->chars) {
+        cold.drop(row->block);
+        row->block = NULL;
+    } else if (row->atom) {
+        LineAtom *atom = row->atom;
+        if (row->render == atom->render) row->render = NULL;
+        if (row->hl == atom->hl.load()) row->hl = NULL;
+        row->atom = NULL;
+        lines.release(atom);
+        row->chars = NULL;
+    }
+    row->chars = (char *)realloc(row->chars, len + 1);
+    memcpy(row->chars, s, len);
+    row->size = len;
+    row->chars[len] = '\0';
+    editorUpdateRow(row);
+    dirty++;
+    journal.record(JR_SET_ROW, row->idx, 0, s, len);
+    editorNoteEdit(row->idx);
+}
+
+void Buffer::editorInsertNewLine() {
+    if (cursor_x == 0) editorInsertRow(cursor_y, "", 0);
+    else {
+        trow_ *row = &rows[cursor_y];
+        editorRowTouch(row);
+        editorInsertRow(cursor_y + 1, &row->chars[cursor_x], row->size - cursor_x);
+        row = &rows[cursor_y];
+        editorRowUnshare(row);
+        row->size = cursor_x;
+        row->chars[row->size] = '\0';
+        editorUpdateRow(row);
+        journal.record(JR_TRUNCATE_ROW, row->idx, row->size, NULL, 0);
+    }
+    cursor_y++;
+    cursor_x = 0;
+}
+
+/*** ranges ***/
+void LineClip::clear() {
+    for (LineAtom *atom : atoms) owner->lines.release(atom);
+    atoms.clear();
+    owner = NULL;
+}
+
+/* The reverse of unsharing: backs the row with an atom of its text, so a
+ * copy of it only takes a reference. Render and hl stay the row's own. */
+LineAtom *Buffer::editorRowShare(trow_ *row) {
+    if (row->atom) return row->atom;
+    LineAtom *atom = lines.intern(editorRowText(row), row->size);
+    if (row->chars) {
+        free(row->chars);
+    } else {
+        cold.drop(row->block);
+        row->block = NULL;
+    }
+    row->chars = atom->chars;
+    row->atom = atom;
+    return atom;
+}
+
+void Buffer::editorCopyRows(int from, int to, LineClip &clip) {
+    clip.clear();
+    clip.owner = this;
+    for (int j = from; j <= to && j < numrows; j++) {
+        LineAtom *atom = editorRowShare(&rows[j]);
+        lines.acquire(atom);
+        clip.atoms.push_back(atom);
+    }
+}
+
+/* Inserts rows sharing atoms of this buffer's table with one memmove and
+ * one rebuild of each index; rows are rendered and lexed once, reusing
+ * the atoms' render and hl where they have them. */
+void Buffer::editorInsertAtoms(int at, const std::vector<LineAtom *> &atoms) {
+    int count = atoms.size();
+    if (at < 0 || at > numrows || count == 0) return;
+
+    rows = (trow_*)realloc(rows, sizeof(trow_) * (numrows + count));
+    memmove(&rows[at + count], &rows[at], sizeof(trow_) * (numrows - at));
+    for (int j = at + count; j < numrows + count; j++) rows[j].idx += count;
+
+    int open_comment = at > 0 && rows[at - 1].hl_open_comment;
+    std::vector<int64_t> lens(count);
+    for (int k = 0; k < count; k++) {
+        LineAtom *atom = atoms[k];
+        lines.acquire(atom);
+        trow_ *row = &rows[at + k];
+        row->idx = at + k;
+        row->size = atom->size;
+        row->chars = atom->chars;
+        row->render = NULL;
+        row->hl = NULL;
+        row->cols = NULL;
+        row->hl_open_comment = open_comment;
+        row->atom = atom;
+        row->block = NULL;
+        row->slot = 0;
+        lens[k] = atom->size + 1;
+        journal.record(JR_INSERT_ROW, at + k, 0, atom->chars, atom->size);
+    }
+    numrows += count;
+    if (wrap_width) wraps.insert(at, std::vector<int>(count, 1));
+    lengths.insert(at, lens);
+    if (diff.active()) diff.rowsInserted(at, count);
+
+    for (int k = 0; k < count; k++) editorUpdateRender(&rows[at + k]);
+    editorUpdateSyntaxRange(at, at + count - 1);
+    dirty++;
+    editorNoteEdit(at);
+}
+
+/* Atoms of another buffer are interned here first; same text still ends
+ * up shared with any equal line already in this buffer's table. */
+void Buffer::editorPasteRows(int at, const LineClip &clip) {
+    if (clip.owner == this) {
+        editorInsertAtoms(at, clip.atoms);
+        return;
+    }
+    std::vector<LineAtom *> atoms;
+    for (LineAtom *atom : clip.atoms) atoms.push_back(lines.intern(atom->chars, atom->size));
+    editorInsertAtoms(at, atoms);
+    for (LineAtom *atom : atoms) lines.release(atom);
+}
+
+void Buffer::editorDelRows(int from, int to) {
+    if (from < 0) from = 0;
+    if (to >= numrows) to = numrows - 1;
+    int count = to - from + 1;
+    if (count <= 0) return;
+
+    for (int j = from; j <= to; j++) {
+        editorFreeRow(&rows[j]);
+        journal.record(JR_DELETE_ROW, from, 0, NULL, 0);
+    }
+    memmove(&rows[from], &rows[to + 1], sizeof(trow_) * (numrows - to - 1));
+    numrows -= count;
+    for (int j = from; j < numrows; j++) rows[j].idx -= count;
+    if (wrap_width) wraps.erase(from, count);
+    lengths.erase(from, count);
+    if (diff.active()) diff.rowsDeleted(from, count);
+    dirty++;
+    editorNoteEdit(from);
+    if (from < numrows) editorUpdateSyntaxRange(from, from - 1);
+}
+
+/* Moves rows from .. to by one row up (by < 0) or down, as a delete and a
+ * re-insert of the same atoms: no text is copied. */
+bool Buffer::editorMoveRows(int from, int to, int by) {
+    if (from < 0 || to >= numrows || from > to) return false;
+    if ((by < 0 && from == 0) || (by > 0 && to == numrows - 1)) return false;
+    by = by < 0 ? -1 : 1;
+
+    LineClip moved;
+    editorCopyRows(from, to, moved);
+    editorDelRows(from, to);
+    editorInsertAtoms(from + by, moved.atoms);
+    moved.clear();
+    return true;
+}
+
+/* Puts a tab in front of every non-empty row, or takes away one tab or up
+ * to tab_stop spaces; each row is re-rendered and lexed once. */
+void Buffer::editorIndentRows(int from, int to, bool dedent) {
+    if (from < 0) from = 0;
+    if (to >= numrows) to = numrows - 1;
+    if (from > to) return;
+
+    for (int j = from; j <= to; j++) {
+        trow_ *row = &rows[j];
+        editorRowTouch(row);
+        int n = 0;
+        if (dedent) {
+            if (row->size > 0 && row->chars[0] == '\t') n = 1;
+            else while (n < row->size && n < cfg.config.tab_stop && row->chars[n] == ' ') n++;
+        }
+        if (dedent ? n == 0 : row->size == 0) continue;
+
+        /* The shared render and hl are about to be rebuilt; don't copy them. */
+        LineAtom *atom = row->atom;
+        if (atom && row->render == atom->render) row->render = NULL;
+        if (atom && row->hl == atom->hl.load()) row->hl = NULL;
+        editorRowUnshare(row);
+
+        if (dedent) {
+            memmove(row->chars, row->chars + n, row->size - n + 1);
+            row->size -= n;
+            for (int k = 0; k < n; k++) journal.record(JR_DELETE_CHAR, j, 0, NULL, 0);
+        } else {
+            row->chars = (char *)realloc(row->chars, row->size + 2);
+            memmove(row->chars + 1, row->chars, row->size + 1);
+            row->chars[0] = '\t';
+            row->size++;
+            journal.record(JR_INSERT_CHAR, j, 0, "\t", 1);
+        }
+        lengths.set(j, row->size + 1);
+        if (diff.active()) diff.rowChanged(j);
+        editorUpdateRender(row);
+    }
+    editorUpdateSyntaxRange(from, to);
+    dirty++;
+    editorNoteEdit(from);
+}
+
+/*** cold rows ***/
+const char *Buffer::editorRowText(trow_ *row) {
+    if (row->chars) return row->chars;
+    return cold.peek(row->block) + row->block->starts[row->slot];
+}
+
+void Buffer::editorThawRow(trow_ *row) {
+    const char *text = editorRowText(row);
+    row->chars = (char *)malloc(row->size + 1);
+    memcpy(row->chars, text, row->size);
+    row->chars[row->size] = '\0';
+
+    ColdBlock *block = row->block;
+    row->block = NULL;
+    cold.stats.thaws++;
+    cold.drop(block);
+}
+
+void Buffer::editorNoteEdit(int at) {
+    edit_sites[next_edit_site] = at;
+    next_edit_site = (next_edit_site + 1) % COLD_EDIT_SITES;
+}
+
+bool Buffer::editorNearEdit(int at) {
+    for (int site : edit_sites) {
+        if (site >= 0 && at >= site - COLD_EDIT_MARGIN && at <= site + COLD_EDIT_MARGIN) return true;
+    }
+    return false;
+}
+
+/* Packs runs of plain rows outside [keep_from, keep_to] and away from recent
+ * edits into compressed blocks, dropping their render and hl. */
+int Buffer::editorFreeze(int keep_from, int keep_to) {
+    int frozen = 0;
+    std::string raw;
+    std::vector<uint32_t> starts;
+    std::vector<int> members;
+
+    auto pack = [&]() {
+        if ((int)members.size() >= COLD_MIN_ROWS) {
+            ColdBlock *block = cold.pack(raw, starts);
+            for (size_t k = 0; k < members.size(); k++) {
+                trow_ *row = &rows[members[k]];
+                free(row->chars);
+                free(row->render);
+                free(row->hl);
+                free(row->cols);
+                row->chars = NULL;
+                row->render = NULL;
+                row->hl = NULL;
+                row->cols = NULL;
+                row->block = block;
+                row->slot = k;
+            }
+            frozen += members.size();
+        }
+        raw.clear();
+        starts.clear();
+        members.clear();
+    };
+
+    for (int j = 0; j < numrows; j++) {
+        trow_ *row = &rows[j];
+        if (row->atom || !row->chars || (j >= keep_from && j <= keep_to) || editorNearEdit(j)) {
+            pack();
+            continue;
+        }
+        starts.push_back(raw.size());
+        raw.append(row->chars, row->size);
+        members.push_back(j);
+        if (members.size() == COLD_BLOCK_ROWS) pack();
+    }
+    pack();
+    return frozen;
+}
+
+/*** derived cache ***/
+/* Bytes of render, hl and column maps held privately by rows; copies
+ * borrowed from atoms belong to the line table and are not counted. */
+size_t Buffer::editorDerivedBytes() const {
+    size_t bytes = 0;
+    for (int j = 0; j < numrows; j++) {
+        const trow_ *row = &rows[j];
+        const LineAtom *atom = row->atom;
+        if (row->render && !(atom && row->render == atom->render)) bytes += row->r_size + 1;
+        if (row->hl && !(atom && row->hl == atom->hl.load(std::memory_order_relaxed))) bytes += row->r_size + 1;
+        if (row->cols) bytes += sizeof(int) * 2 * (row->size + 1);
+    }
+    return bytes;
+}
+
+/* Frees render, hl and column maps outside [keep_from, keep_to]. The lexer state at the
+ * end of each row is kept, so they are rebuilt on demand like a fresh load. */
+void Buffer::editorDropDerived(int keep_from, int keep_to) {
+    for (int j = 0; j < numrows; j++) {
+        if (j >= keep_from && j <= keep_to) continue;
+        trow_ *row = &rows[j];
+        LineAtom *atom = row->atom;
+        if (!(atom && row->render == atom->render)) free(row->render);
+        if (!(atom && row->hl == atom->hl.load(std::memory_order_relaxed))) free(row->hl);
+        free(row->cols);
+        row->render = NULL;
+        row->hl = NULL;
+        row->cols = NULL;
+    }
+}
+
+/*** memory ***/
+static size_t heapSize(void *p, size_t asked) {
+    if (!p) return 0;
+    #ifdef __GLIBC__
+    asked = malloc_usable_size(p);
+    #endif
+    return asked;
+}
+
+void Buffer::editorMemStats(MemStats &st) {
+    memset(&st, 0, sizeof(st));
+    st.rows = sizeof(trow_) * numrows;
+    st.rows_slack = heapSize(rows, st.rows) - st.rows;
+    for (int j = 0; j < numrows; j++) {
+        const trow_ *row = &rows[j];
+        const LineAtom *atom = row->atom;
+        if (row->chars && !atom) {
+            size_t used = heapSize(row->chars, row->size + 1);
+            st.chars += row->size + 1;
+            st.chars_slack += used - (row->size + 1);
+        }
+        if (row->render && !(atom && row->render == atom->render)) st.render += heapSize(row->render, row->r_size + 1);
+        if (row->hl && !(atom && row->hl == atom->hl.load(std::memory_order_relaxed))) st.hl += heapSize(row->hl, row->r_size + 1);
+        if (row->cols) st.cols += heapSize(row->cols, sizeof(int) * 2 * (row->size + 1));
+    }
+    st.shared = lines.bytes();
+    st.cold = cold.bytes();
+    st.index = offsets.capacity() * sizeof(uint64_t) + wraps.bytes() + lengths.bytes() + diff.bytes();
+}
+
+/* Gives back what edits and dropped caches left over: render and hl go
+ * outside [keep_from, keep_to], the rows array and indexes shrink to
+ * their length, and private row text is moved out, the heap trimmed and
+ * the text copied back end to end, so holes between rows don't pin pages. */
+void Buffer::editorCompact(int keep_from, int keep_to) {
+    editorDropDerived(keep_from, keep_to);
+    cold.trim();
+    offsets.shrink_to_fit();
+    wraps.shrink();
+    lengths.shrink();
+    diff.shrink();
+    if (numrows > 0) rows = (trow_*)realloc(rows, sizeof(trow_) * numrows);
+
+    /* Sized exactly up front: a doubling string would hold up to twice the
+     * text on top of the rows it is copied from. */
+    size_t total = 0;
+    for (int j = 0; j < numrows; j++) {
+        if (rows[j].chars && !rows[j].atom) total += rows[j].size + 1;
+    }
+    std::string packed;
+    packed.reserve(total);
+    for (int j = 0; j < numrows; j++) {
+        trow_ *row = &rows[j];
+        if (row->chars && !row->atom) packed.append(row->chars, row->size + 1);
+    }
+    for (int j = 0; j < numrows; j++) {
+        trow_ *row = &rows[j];
+        if (row->chars && !row->atom) free(row->chars);
+    }
+    #ifdef __GLIBC__
+    malloc_trim(0);
+    #endif
+    const char *p = packed.data();
+    for (int j = 0; j < numrows; j++) {
+        trow_ *row = &rows[j];
+        if (!row->chars || row->atom) continue;
+        row->chars = (char*)malloc(row->size + 1);
+        memcpy(row->chars, p, row->size + 1);
+        p += row->size + 1;
+    }
+}
+
+/*** soft wrap ***/
+/* Counts come from row widths alone, so a resize never touches row text. */
+void Buffer::editorSetWrap(int width) {
+    wrap_width = width > 0 ? width : 0;
+    if (!wrap_width) {
+        wraps.clear();
+        return;
+    }
+    std::vector<int> counts(numrows);
+    for (int j = 0; j < numrows; j++) counts[j] = editorRowWrapCount(&rows[j]);
+    wraps.assign(std::move(counts));
+}
+
+int Buffer::editorRowWrapSub(const trow_ *row, int rx) const {
+    return std::min(rx / wrap_width, editorRowWrapCount(row) - 1);
+}
+
+int Buffer::editorRowAtVisual(int v, int *sub) const {
+    int at = wraps.find(v);
+    *sub = at < numrows ? v - wraps.prefix(at) : 0;
+    return at;
+}
+
+/*** byte offsets ***/
+/* Row holding the byte at offset and the column of that byte in it; the
+ * newline maps to the end of the row, offsets past the end to numrows. */
+int Buffer::editorRowAtOffset(uint64_t offset, int *col) const {
+    int at = lengths.find(offset);
+    *col = at < numrows ? std::min<int64_t>(offset - lengths.prefix(at), rows[at].size) : 0;
+    return at;
+}
+
+void Buffer::editorGotoOffset(uint64_t offset) {
+    cursor_y = editorRowAtOffset(offset, &cursor_x);
+}
+
+/* Decimal, or hex with 0x as crash dumps print it. */
+int Buffer::parseOffset(const char *s, uint64_t *offset) {
+    int base = (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) ? 16 : 10;
+    if (!isxdigit((unsigned char)s[base == 16 ? 2 : 0])) return -1;
+
+    char *end;
+    errno = 0;
+    *offset = strtoull(s, &end, base);
+    return (*end || errno) ? -1 : 0;
+}
+
+/* A line number from 1, in decimal and nothing after it. */
+int Buffer::parseLine(const char *s, int *line) {
+    if (!isdigit((unsigned char)s[0])) return -1;
+
+    char *end;
+    errno = 0;
+    long n = strtol(s, &end, 10);
+    if (*end || errno || n < 1 || n > INT_MAX) return -1;
+    *line = n;
+    return 0;
+}
+
+/*** diff ***/
+uint64_t Buffer::editorRowHash(int at) {
+    trow_ *row = &rows[at];
+    if (row->atom) return row->atom->hash;
+    return lineHash(editorRowText(row), row->size);
+}
+
+/* base holds the line hashes of the file on disk, see diffHashFile. */
+void Buffer::editorDiffStart(std::vector<uint64_t> &&base) {
+    std::vector<uint64_t> hashes(numrows);
+    for (int j = 0; j < numrows; j++) hashes[j] = editorRowHash(j);
+    diff.start(std::move(base), hashes);
+}
+
+void Buffer::editorDiffUpdate() {
+    if (!diff.pending()) return;
+    diff.update([this](int at) { return editorRowHash(at); });
+}
+
+/*** search ***/
+int Buffer::editorFindNext(const char *query, int last_match, int direction, int *match_rx) {
+    int curr = last_match;
+    for (int i = 0; i < numrows; i++) {
+        curr += direction;
+        if (curr == -1) curr = numrows - 1;
+        else if (curr == numrows) curr = 0;
+
+        trow_ *row = &rows[curr];
+        if (!row->chars) {
+            /* Search a cold row in a scratch render; only a hit is thawed. */
+            int r_size, width;
+            bool ascii;
+            char *render = renderLine(editorRowText(row), row->size, &r_size, &width, &ascii);
+            char *match = strstr(render, query);
+            if (match) *match_rx = match - render;
+            free(render);
+            if (!match) continue;
+            editorRowPrepare(row);
+            return curr;
+        }
+
+        editorRowPrepare(row);
+        char *match = strstr(row->render, query);
+        if (match) {
+            *match_rx = match - row->render;
+            return curr;
+        }
+    }
+    return -1;
+}
+
+/*** output ***/
+void Buffer::editorDrawRow(std::string &ab, int at, int col_offset, int cols) {
+    trow_ *row = &rows[at];
+    editorRowPrepare(row);
+
+    /* A wide character cut by either edge shows as '<' or '>'. */
+    int b = col_offset, c = col_offset;
+    if (!row->ascii) {
+        int *col = editorRowCols(row);
+        int cx = std::lower_bound(col, col + row->size + 1, col_offset) - col;
+        if (cx > row->size) {
+            b = row->r_size;
+        } else {
+            c = col[cx];
+            b = col[row->size + 1 + cx];
+        }
+    }
+    int used = std::min(c - col_offset, cols);
+    ab.append(used, '<');
+
+    int current_color = -1;
+    while (b < row->r_size && used < cols) {
+        const char *p = &row->render[b];
+        uint32_t cp = (unsigned char)*p;
+        int n = 1;
+        int w;
+        if (cp < 0x80) w = (cp < 0x20 || cp == 0x7f) ? -1 : 1;
+        else {
+            n = utf8Decode(p, row->r_size - b, &cp);
+            w = utf8Width(cp);
+        }
+
+        if (w < 0) {
+            char sym = (cp <= 26) ? '@' + cp : '?';
+            ab.append("\x1b[7m", 4);
+            ab.append(&sym, 1);
+            ab.append("\x1b[m", 3);
+            if (current_color != -1) {
+                char seq[16];
+                int len = snprintf(seq, sizeof(seq), "\x1b[%dm", current_color);
+                ab.append(seq, len);
+            }
+            w = 1;
+        } else if (used + w > cols) {
+            ab.append(cols - used, '>');
+            break;
+        } else if (row->hl[b] == HL_NORMAL) {
+            if (current_color != -1) {
+                ab.append("\x1b[39m", 5);
+                current_color = -1;
+            }
+            ab.append(p, n);
+        } else {
+            int color = editorSyntaxToColor(row->hl[b]);
+            if (color != current_color) {
+                current_color = color;
+                char seq[16];
+                int len = snprintf(seq, sizeof(seq), "\x1b[1;%dm", color);
+                ab.append(seq, len);
+            }
+            ab.append(p, n);
+        }
+        b += n;
+        used += w;
+    }
+    ab.append("\x1b[39m", 5);
+}
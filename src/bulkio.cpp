@@ -0,0 +1,317 @@
+/*** includes ***/
+#include "include/bulkio.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+
+/*** plain io ***/
+/* Moves len bytes at off, retrying short transfers; returns what was done
+ * before end of file, or -1. A non-seekable fd is read sequentially. */
+static ssize_t plainIO(bool write, int fd, bool seekable, char *buf, size_t len, uint64_t off) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n;
+        if (write) n = pwrite(fd, buf + done, len - done, off + done);
+        else if (seekable) n = pread(fd, buf + done, len - done, off + done);
+        else n = read(fd, buf + done, len - done);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) return -1;
+        if (n == 0) break;
+        done += n;
+    }
+    return done;
+}
+
+/*** ring ***/
+/* Elsewhere than Linux io_uring=1 quietly means the plain path. */
+BulkIO::BulkIO(bool use_uring)
+    : want_uring(use_uring), fd(-1), regular(false), size(0), offset(0), queued(0), current(0), error(0),
+      ring_fd(-1), sq_ptr(MAP_FAILED), cq_ptr(MAP_FAILED), sq_len(0), cq_len(0),
+      sqes((io_uring_sqe *)MAP_FAILED) {
+    #ifndef __linux__
+    want_uring = false;
+    #endif
+    if (posix_memalign((void **)&bufs, 4096, (size_t)BULKIO_DEPTH * BULKIO_CHUNK) != 0) bufs = NULL;
+    memset(slots, 0, sizeof(slots));
+}
+
+BulkIO::~BulkIO() {
+    #ifdef __linux__
+    if (ring_fd >= 0) {
+        drain();
+        if (sqes != MAP_FAILED) munmap(sqes, BULKIO_DEPTH * sizeof(io_uring_sqe));
+        if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) munmap(cq_ptr, cq_len);
+        if (sq_ptr != MAP_FAILED) munmap(sq_ptr, sq_len);
+        close(ring_fd);
+    }
+    #endif
+    free(bufs);
+}
+
+#ifdef __linux__
+int BulkIO::setupRing() {
+    io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int rfd = syscall(__NR_io_uring_setup, BULKIO_DEPTH, &p);
+    if (rfd < 0) return -1;
+    ring_fd = rfd;
+
+    sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single) sq_len = cq_len = sq_len > cq_len ? sq_len : cq_len;
+
+    sq_ptr = mmap(NULL, sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, rfd, IORING_OFF_SQ_RING);
+    if (sq_ptr != MAP_FAILED) {
+        cq_ptr = single ? sq_ptr
+                        : mmap(NULL, cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, rfd, IORING_OFF_CQ_RING);
+    }
+    if (cq_ptr != MAP_FAILED) {
+        sqes = (io_uring_sqe *)mmap(NULL, p.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE, rfd, IORING_OFF_SQES);
+    }
+
+    iovec iov[BULKIO_DEPTH];
+    for (int s = 0; s < BULKIO_DEPTH; s++) {
+        iov[s].iov_base = chunk(s);
+        iov[s].iov_len = BULKIO_CHUNK;
+    }
+    if (sqes == MAP_FAILED || p.sq_entries != BULKIO_DEPTH ||
+        syscall(__NR_io_uring_register, rfd, IORING_REGISTER_BUFFERS, iov, BULKIO_DEPTH) != 0) {
+        if (sqes != MAP_FAILED) munmap(sqes, p.sq_entries * sizeof(io_uring_sqe));
+        if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) munmap(cq_ptr, cq_len);
+        if (sq_ptr != MAP_FAILED) munmap(sq_ptr, sq_len);
+        sqes = (io_uring_sqe *)MAP_FAILED;
+        cq_ptr = sq_ptr = MAP_FAILED;
+        close(rfd);
+        ring_fd = -1;
+        return -1;
+    }
+
+    char *sq = (char *)sq_ptr;
+    sq_head = (unsigned *)(sq + p.sq_off.head);
+    sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    sq_array = (unsigned *)(sq + p.sq_off.array);
+    char *cq = (char *)cq_ptr;
+    cq_head = (unsigned *)(cq + p.cq_off.head);
+    cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    cqes = (io_uring_cqe *)(cq + p.cq_off.cqes);
+    return 0;
+}
+
+/* Queues one fixed-buffer transfer; if the kernel refuses it the slot is
+ * done in place so the caller never sees the difference. */
+void BulkIO::submit(int slot, bool write, uint64_t off, size_t len) {
+    Slot &s = slots[slot];
+    s.busy = true;
+    s.len = len;
+    s.done = -1;
+    s.offset = off;
+
+    unsigned tail = *sq_tail;
+    unsigned idx = tail & *sq_mask;
+    io_uring_sqe *sqe = &sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+    sqe->fd = fd;
+    sqe->off = off;
+    sqe->addr = (uint64_t)(uintptr_t)chunk(slot);
+    sqe->len = len;
+    sqe->buf_index = slot;
+    sqe->user_data = slot | (write ? 0x100 : 0);
+    sq_array[idx] = idx;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int n;
+    do n = syscall(__NR_io_uring_enter, ring_fd, 1, 0, 0, NULL, 0);
+    while (n == -1 && errno == EINTR);
+    if (n == 1) {
+        queued++;
+        return;
+    }
+    /* Not consumed: take the entry back and do the transfer here. */
+    __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+    s.done = plainIO(write, fd, true, chunk(slot), len, off);
+    if (s.done == -1 && !error) error = errno;
+}
+
+/* Waits for one completion; a short or interrupted transfer is finished
+ * with plain I/O. */
+int BulkIO::reap() {
+    unsigned head = *cq_head;
+    while (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+        if (syscall(__NR_io_uring_enter, ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) == -1 && errno != EINTR) {
+            if (!error) error = errno;
+            return -1;
+        }
+    }
+    io_uring_cqe *cqe = &cqes[head & *cq_mask];
+    int slot = cqe->user_data & 0xff;
+    bool write = cqe->user_data & 0x100;
+    int res = cqe->res;
+    __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+    queued--;
+
+    Slot &s = slots[slot];
+    if (res == -EAGAIN || res == -EINTR) res = 0;
+    if (res < 0) {
+        if (!error) error = -res;
+        s.done = 0;
+        return 0;
+    }
+    s.done = res;
+    if ((size_t)res < s.len) {
+        ssize_t rest = plainIO(write, fd, true, chunk(slot) + res, s.len - res, s.offset + res);
+        if (rest == -1) {
+            if (!error) error = errno;
+        } else {
+            s.done += rest;
+        }
+    }
+    return 0;
+}
+#else
+int BulkIO::setupRing() {
+    return -1;
+}
+
+void BulkIO::submit(int slot, bool write, uint64_t off, size_t len) {
+    slots[slot].busy = true;
+    slots[slot].len = len;
+    slots[slot].offset = off;
+    slots[slot].done = plainIO(write, fd, true, chunk(slot), len, off);
+    if (slots[slot].done == -1 && !error) error = errno;
+}
+
+int BulkIO::reap() {
+    return -1;
+}
+#endif
+
+void BulkIO::drain() {
+    while (queued > 0 && reap() == 0) {}
+}
+
+/* A transfer given up half way (a read error) may still have chunks in
+ * flight; they land before the chunks are handed out again. */
+void BulkIO::reset() {
+    drain();
+    queued = 0;
+    memset(slots, 0, sizeof(slots));
+}
+
+/*** reading ***/
+int BulkIO::startRead(int fd) {
+    if (!bufs) {
+        errno = ENOMEM;
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) return -1;
+    reset();
+    this->fd = fd;
+    regular = S_ISREG(st.st_mode);
+    size = st.st_size;
+    offset = 0;
+    current = 0;
+    error = 0;
+
+    /* The ring is only set up for files big enough to pay for it. */
+    if (want_uring && regular && size > BULKIO_CHUNK && ring_fd == -1) setupRing();
+    if (ring_fd < 0) return 0;
+    for (int s = 0; s < BULKIO_DEPTH && offset < size; s++) {
+        size_t len = size - offset < BULKIO_CHUNK ? size - offset : BULKIO_CHUNK;
+        submit(s, false, offset, len);
+        offset += len;
+    }
+    return 0;
+}
+
+ssize_t BulkIO::next(const char **data) {
+    if (ring_fd < 0) {
+        ssize_t n = plainIO(false, fd, regular, chunk(0), BULKIO_CHUNK, offset);
+        if (n > 0) offset += n;
+        *data = chunk(0);
+        return n;
+    }
+
+    /* The chunk handed out last time is free again: refill it. */
+    int last = (current + BULKIO_DEPTH - 1) % BULKIO_DEPTH;
+    if (!slots[last].busy && offset < size) {
+        size_t len = size - offset < BULKIO_CHUNK ? size - offset : BULKIO_CHUNK;
+        submit(last, false, offset, len);
+        offset += len;
+    }
+
+    Slot &s = slots[current];
+    if (!s.busy) return 0;
+    while (s.done == -1 && reap() == 0) {}
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    s.busy = false;
+    *data = chunk(current);
+    current = (current + 1) % BULKIO_DEPTH;
+    return s.done;
+}
+
+/*** writing ***/
+void BulkIO::startWrite(int fd, uint64_t total) {
+    reset();
+    this->fd = fd;
+    regular = true;
+    size = total;
+    offset = 0;
+    current = 0;
+    error = bufs ? 0 : ENOMEM;
+    if (want_uring && bufs && total > BULKIO_CHUNK && ring_fd == -1) setupRing();
+}
+
+int BulkIO::put(size_t len) {
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    if (ring_fd < 0) {
+        ssize_t n = plainIO(true, fd, true, chunk(0), len, offset);
+        offset += len;
+        if (n == -1) return -1;
+        return 0;
+    }
+
+    submit(current, true, offset, len);
+    offset += len;
+    current = (current + 1) % BULKIO_DEPTH;
+
+    /* The next chunk to fill must be off the queue. */
+    Slot &s = slots[current];
+    while (s.busy && s.done == -1 && reap() == 0) {}
+    s.busy = false;
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+int BulkIO::finish() {
+    if (ring_fd >= 0) drain();
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*** includes ***/
+#include "include/cold.hpp"
+#include "include/lz.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*** store ***/
+ColdStore::ColdStore() : stats(), head(NULL), cached(NULL) {}
+
+ColdStore::~ColdStore() {
+    clear();
+}
+
+void ColdStore::clear() {
+    while (head) {
+        ColdBlock *next = head->next;
+        delete head;
+        head = next;
+    }
+    cached = NULL;
+    cache.clear();
+    cache.shrink_to_fit();
+    stats.rows = stats.blocks = stats.raw_bytes = stats.packed_bytes = 0;
+}
+
+/* Forgets the decompressed block; the next peek pays one decompression. */
+void ColdStore::trim() {
+    cached = NULL;
+    std::string().swap(cache);
+}
+
+ColdBlock *ColdStore::pack(const std::string &raw, const std::vector<uint32_t> &starts) {
+    ColdBlock *block = new ColdBlock();
+    lzCompress(raw.data(), raw.size(), block->data);
+    block->data.shrink_to_fit();
+    block->raw_len = raw.size();
+    block->live = starts.size();
+    block->starts = starts;
+
+    block->prev = NULL;
+    block->next = head;
+    if (head) head->prev = block;
+    head = block;
+
+    stats.rows += starts.size();
+    stats.blocks++;
+    stats.raw_bytes += raw.size();
+    stats.packed_bytes += block->data.size();
+    return block;
+}
+
+const char *ColdStore::peek(ColdBlock *block) {
+    if (block == cached) {
+        stats.hits++;
+        return cache.data();
+    }
+    stats.misses++;
+
+    cache.resize(block->raw_len);
+    if (lzDecompress(block->data.data(), block->data.size(), &cache[0], block->raw_len) == -1) {
+        /* Only ever fed our own output; a failure is memory corruption. */
+        fprintf(stderr, "cold block corrupted\n");
+        abort();
+    }
+    cached = block;
+    return cache.data();
+}
+
+void ColdStore::drop(ColdBlock *block) {
+    stats.rows--;
+    if (--block->live > 0) return;
+
+    if (block->prev) block->prev->next = block->next;
+    else head = block->next;
+    if (block->next) block->next->prev = block->prev;
+
+    stats.blocks--;
+    stats.raw_bytes -= block->raw_len;
+    stats.packed_bytes -= block->data.size();
+    if (cached == block) cached = NULL;
+    delete block;
+}
@@ -0,0 +1,362 @@
+/*** defines ***/
+#define _DEFAULT_SOURCE
+#define _BSD_SOURCE
+
+/*** includes ***/
+#include "include/diff.hpp"
+#include "include/intern.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <unordered_map>
+
+/*** alignment ***/
+/* Greedy Myers over a gap with no unique lines left; the trace of each
+ * round is kept to walk the edit script back. Past DIFF_MAX_EDITS rounds
+ * the path reaching furthest is taken as it is and the search restarts
+ * from its end, so huge gaps stay linear at the cost of optimality. */
+static void myers(const uint64_t *a, int n, const uint64_t *b, int m, int *match, int boff) {
+    while (n > 0 && m > 0) {
+        int max = std::min(n + m, DIFF_MAX_EDITS);
+        std::vector<int> v(2 * max + 3, 0);
+        int zero = max + 1;
+        std::vector<std::vector<int>> trace;
+
+        int end_d = -1, end_k = 0;
+        for (int d = 0; d <= max && end_d < 0; d++) {
+            for (int k = -d; k <= d; k += 2) {
+                int x;
+                if (k == -d || (k != d && v[zero + k - 1] < v[zero + k + 1])) x = v[zero + k + 1];
+                else x = v[zero + k - 1] + 1;
+                int y = x - k;
+                while (x < n && y < m && a[x] == b[y]) {
+                    x++;
+                    y++;
+                }
+                v[zero + k] = x;
+                if (x == n && y == m) {
+                    end_d = d;
+                    end_k = k;
+                    break;
+                }
+            }
+            trace.emplace_back(v.begin() + zero - d, v.begin() + zero + d + 1);
+        }
+        if (end_d < 0) {
+            end_d = max;
+            int best = -1;
+            for (int k = -max; k <= max; k += 2) {
+                int x = v[zero + k], y = x - k;
+                if (x <= n && y >= 0 && y <= m && x + y > best) {
+                    best = x + y;
+                    end_k = k;
+                }
+            }
+        }
+
+        int ex = v[zero + end_k], ey = ex - end_k;
+        int x = ex, y = ey;
+        for (int d = end_d; d > 0; d--) {
+            const std::vector<int> &prev = trace[d - 1];
+            int k = x - y;
+            auto at = [&](int kk) { return prev[kk + d - 1]; };
+            int pk = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? k + 1 : k - 1;
+            int px = at(pk);
+            int py = px - pk;
+            while (x > px && y > py) {
+                x--;
+                y--;
+                match[x] = boff + y;
+            }
+            x = px;
+            y = py;
+        }
+        while (x > 0 && y > 0) {
+            x--;
+            y--;
+            match[x] = boff + y;
+        }
+
+        a += ex;
+        b += ey;
+        match += ex;
+        boff += ey;
+        n -= ex;
+        m -= ey;
+    }
+}
+
+static void alignGap(const uint64_t *a, int n, const uint64_t *b, int m, int *match, int boff) {
+    while (n > 0 && m > 0 && a[0] == b[0]) {
+        *match++ = boff++;
+        a++;
+        b++;
+        n--;
+        m--;
+    }
+    while (n > 0 && m > 0 && a[n - 1] == b[m - 1]) {
+        match[n - 1] = boff + m - 1;
+        n--;
+        m--;
+    }
+    if (n > 0 && m > 0) myers(a, n, b, m, match, boff);
+}
+
+void diffLines(const uint64_t *a, int n, const uint64_t *b, int m, int *match) {
+    std::fill(match, match + n, -1);
+
+    int head = 0;
+    while (head < n && head < m && a[head] == b[head]) {
+        match[head] = head;
+        head++;
+    }
+    int tail = 0;
+    while (tail < n - head && tail < m - head && a[n - 1 - tail] == b[m - 1 - tail]) {
+        match[n - 1 - tail] = m - 1 - tail;
+        tail++;
+    }
+    int an = n - head - tail;
+    int bm = m - head - tail;
+    if (an == 0 || bm == 0) return;
+    a += head;
+    b += head;
+    match += head;
+
+    struct Count { int na, nb, ib; };
+    std::unordered_map<uint64_t, Count> counts;
+    counts.reserve(an + bm);
+    for (int i = 0; i < an; i++) counts[a[i]].na++;
+    for (int j = 0; j < bm; j++) {
+        Count &c = counts[b[j]];
+        c.nb++;
+        c.ib = j;
+    }
+
+    /* Lines unique on both sides, in a's order; the longest run increasing
+     * in b as well becomes the anchors. */
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < an; i++) {
+        const Count &c = counts[a[i]];
+        if (c.na == 1 && c.nb == 1) pairs.push_back({ i, c.ib });
+    }
+    counts.clear();
+
+    std::vector<int> tails, prev(pairs.size());
+    for (size_t k = 0; k < pairs.size(); k++) {
+        auto pos = std::lower_bound(tails.begin(), tails.end(), pairs[k].second,
+            [&](int t, int ib) { return pairs[t].second < ib; });
+        prev[k] = pos == tails.begin() ? -1 : *(pos - 1);
+        if (pos == tails.end()) tails.push_back(k);
+        else *pos = k;
+    }
+    std::vector<std::pair<int, int>> anchors;
+    for (int k = tails.empty() ? -1 : tails.back(); k >= 0; k = prev[k]) anchors.push_back(pairs[k]);
+    std::reverse(anchors.begin(), anchors.end());
+    anchors.push_back({ an, bm });
+
+    int ai = 0, bi = 0;
+    for (auto &anchor : anchors) {
+        alignGap(a + ai, anchor.first - ai, b + bi, anchor.second - bi, match + ai, head + bi);
+        if (anchor.first < an) match[anchor.first] = head + anchor.second;
+        ai = anchor.first + 1;
+        bi = anchor.second + 1;
+    }
+}
+
+int diffHashFile(const char *path, std::vector<uint64_t> &hashes) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+
+    hashes.clear();
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    while ((len = getline(&line, &cap, file)) != -1) {
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) len--;
+        hashes.push_back(lineHash(line, len));
+    }
+    free(line);
+    fclose(file);
+    return 0;
+}
+
+/*** incremental ***/
+LineDiff::LineDiff() : added(0), changed(0), deleted(0), tail_deleted(0), on(false) {}
+
+void LineDiff::start(std::vector<uint64_t> &&base_hashes, const std::vector<uint64_t> &rows) {
+    base.swap(base_hashes);
+    int n = rows.size();
+    match.assign(n, -1);
+    marks.assign(n, 0);
+    dirty.clear();
+    added = changed = deleted = tail_deleted = 0;
+    diffLines(rows.data(), n, base.data(), base.size(), match.data());
+    relabel(-1, n);
+    on = true;
+}
+
+void LineDiff::stop() {
+    std::vector<uint64_t>().swap(base);
+    std::vector<int>().swap(match);
+    std::vector<uint32_t>().swap(marks);
+    dirty.clear();
+    added = changed = deleted = tail_deleted = 0;
+    on = false;
+}
+
+/* The buffer was saved: it is the new base and nothing differs. */
+void LineDiff::rebase(const std::vector<uint64_t> &rows) {
+    base = rows;
+    match.resize(rows.size());
+    for (size_t j = 0; j < rows.size(); j++) match[j] = j;
+    marks.assign(rows.size(), 0);
+    dirty.clear();
+    added = changed = deleted = tail_deleted = 0;
+}
+
+size_t LineDiff::bytes() const {
+    return base.capacity() * sizeof(uint64_t) + match.capacity() * sizeof(int) +
+           marks.capacity() * sizeof(uint32_t) + dirty.capacity() * sizeof(dirty[0]);
+}
+
+void LineDiff::shrink() {
+    base.shrink_to_fit();
+    match.shrink_to_fit();
+    marks.shrink_to_fit();
+    dirty.shrink_to_fit();
+}
+
+void LineDiff::rowInserted(int at) {
+    rowsInserted(at, 1);
+}
+
+void LineDiff::rowDeleted(int at) {
+    rowsDeleted(at, 1);
+}
+
+void LineDiff::rowChanged(int at) {
+    match[at] = -1;
+    touch(at, at);
+}
+
+void LineDiff::rowsInserted(int at, int n) {
+    match.insert(match.begin() + at, n, -1);
+    marks.insert(marks.begin() + at, n, 0);
+    shift(at, n);
+    touch(at, at + n - 1);
+}
+
+void LineDiff::rowsDeleted(int at, int n) {
+    for (int j = at; j < at + n; j++) setMark(j, DIFF_SAME, 0);
+    match.erase(match.begin() + at, match.begin() + at + n);
+    marks.erase(marks.begin() + at, marks.begin() + at + n);
+    shift(at, -n);
+    touch(at, at);
+}
+
+void LineDiff::touch(int from, int to) {
+    for (auto &d : dirty) {
+        if (to >= d.first - 1 && from <= d.second + 1) {
+            d.first = std::min(d.first, from);
+            d.second = std::max(d.second, to);
+            return;
+        }
+    }
+    dirty.push_back({ from, to });
+    if (dirty.size() <= DIFF_MAX_WINDOWS) return;
+
+    /* Edits all over the file: one wide window is cheaper to track. */
+    int lo = from, hi = to;
+    for (auto &d : dirty) {
+        lo = std::min(lo, d.first);
+        hi = std::max(hi, d.second);
+    }
+    dirty.assign(1, { lo, hi });
+}
+
+/* Moves windows past at by an insertion (by > 0) or a deletion of -by
+ * rows; the parts of a window inside deleted rows collapse onto at. */
+void LineDiff::shift(int at, int by) {
+    for (auto &d : dirty) {
+        if (d.first > at) d.first = std::max(d.first + by, at);
+        if (d.second >= at) d.second = std::max(d.second + by, at - 1);
+    }
+}
+
+void LineDiff::update(const std::function<uint64_t(int)> &hashRow) {
+    if (!on || dirty.empty()) return;
+    int n = match.size();
+    std::sort(dirty.begin(), dirty.end());
+
+    /* Widen every window to the nearest rows still matched on both sides;
+     * windows that then overlap are diffed as one. */
+    std::vector<std::pair<int, int>> windows;
+    for (auto &d : dirty) {
+        int from = std::min(d.first, n);
+        int to = std::min(d.second, n - 1);
+        int a = from - 1;
+        while (a >= 0 && match[a] < 0) a--;
+        int b = std::max(to + 1, from);
+        while (b < n && match[b] < 0) b++;
+        if (!windows.empty() && a < windows.back().second) windows.back().second = std::max(windows.back().second, b);
+        else windows.push_back({ a, b });
+    }
+    dirty.clear();
+
+    std::vector<uint64_t> hashes;
+    std::vector<int> seg;
+    for (auto &w : windows) {
+        int a = w.first, b = w.second;
+        hashes.clear();
+        for (int j = a + 1; j < b; j++) hashes.push_back(hashRow(j));
+        int bfrom = a >= 0 ? match[a] + 1 : 0;
+        int bto = b < n ? match[b] : (int)base.size();
+
+        seg.resize(hashes.size());
+        diffLines(hashes.data(), hashes.size(), base.data() + bfrom, bto - bfrom, seg.data());
+        for (size_t k = 0; k < seg.size(); k++) match[a + 1 + k] = seg[k] >= 0 ? seg[k] + bfrom : -1;
+        relabel(a, b);
+    }
+}
+
+/* Marks rows from + 1 .. to from the matches between two anchors: in a
+ * run of unmatched rows facing g removed base lines, the first g rows are
+ * changed and the rest added; base lines left over show as deleted above
+ * the next row, or at the end of the file. */
+void LineDiff::relabel(int from, int to) {
+    int n = match.size();
+    int p = from >= 0 ? match[from] + 1 : 0;
+    int r = from + 1;
+    while (true) {
+        int s = r;
+        while (r < to && match[r] < 0) r++;
+        int end = r < n ? match[r] : (int)base.size();
+        int k = r - s;
+        int g = end - p;
+        for (int j = s; j < r; j++) setMark(j, j - s < g ? DIFF_CHANGED : DIFF_ADDED, 0);
+        int removed = g > k ? g - k : 0;
+
+        if (r >= n) {
+            deleted += removed - tail_deleted;
+            tail_deleted = removed;
+            break;
+        }
+        setMark(r, DIFF_SAME, removed);
+        p = match[r] + 1;
+        if (r >= to) break;
+        r++;
+    }
+}
+
+void LineDiff::setMark(int at, int kind, int removed) {
+    uint32_t old = marks[at];
+    if ((old & 3) == DIFF_ADDED) added--;
+    else if ((old & 3) == DIFF_CHANGED) changed--;
+    deleted -= old >> 2;
+
+    marks[at] = kind | (uint32_t)removed << 2;
+    if (kind == DIFF_ADDED) added++;
+    else if (kind == DIFF_CHANGED) changed++;
+    deleted += removed;
+}
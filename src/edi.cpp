@@ -1,11 +1,27 @@
 #include "include/term.hpp"
+#include "include/batch.hpp"
+#include "include/config.hpp"
 
 int main(int argc, char **argv) {
+    if (argc >= 2 && !strcmp(argv[1], "--batch")) {
+        if (argc < 4) {
+            fprintf(stderr, "usage: edi --batch SCRIPT FILE...\n");
+            return 2;
+        }
+        /* Settings are read once, before any worker starts; without a
+         * config file the defaults stand. */
+        std::string dir = Config::defaultDir();
+        if (!dir.empty()) cfg.loadConfig(dir + "/config.conf");
+
+        Batch batch;
+        if (batch.load(argv[2]) == -1) return 2;
+        return batch.run(argc - 3, argv + 3);
+    }
+
     Term term;
     term.initEditor();
-    if(argc >= 2) term.editorOpen(argv[1]);
-    
     term.editorSetStatusMessage("HELP: CTRL-S = save | CTRL-Q = quit | CTRL-F = find");
+    for (int i = 1; i < argc; i++) term.editorOpen(argv[i]);
 
     while (true) {
         term.editorRefreshScreen();
@@ -13,4 +29,4 @@ int main(int argc, char **argv) {
     }
     
     return 0;
-}
\ No newline at end of file
+}
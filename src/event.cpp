@@ -0,0 +1,224 @@
+/*** includes ***/
+#include "include/event.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#endif
+
+/*** helpers ***/
+static long long nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void drain(int fd) {
+    char buf[64];
+    while (read(fd, buf, sizeof(buf)) > 0) {}
+}
+
+#ifndef __linux__
+static int sigpipe_fd = -1;
+
+static void onWinch(int) {
+    int saved = errno;
+    char c = 'w';
+    if (write(sigpipe_fd, &c, 1) == -1) {}
+    errno = saved;
+}
+#endif
+
+/*** event loop ***/
+EventLoop::EventLoop()
+    : input(-1), output(-1), epfd(-1), sigfd(-1), timerfd(-1), wakefd{-1, -1},
+      deadline_ms(0), stopping(false) {}
+
+/* Quitting waits only for the job the worker is in the middle of: the
+ * queued ones are dropped and nothing is left to run their completions. */
+EventLoop::~EventLoop() {
+    std::deque<Job> dropped;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        dropped.swap(jobs);
+        completions.clear();
+    }
+    cond.notify_one();
+    if (thread.joinable()) thread.join();
+
+    if (epfd != -1) close(epfd);
+    if (sigfd != -1) close(sigfd);
+    if (timerfd != -1) close(timerfd);
+    if (wakefd[0] != -1) close(wakefd[0]);
+    if (wakefd[1] != -1 && wakefd[1] != wakefd[0]) close(wakefd[1]);
+}
+
+int EventLoop::open(int input_fd) {
+    input = input_fd;
+
+    #ifdef __linux__
+    /* Blocked before any thread starts, so only signalfd ever sees it. */
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGWINCH);
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) == -1) return -1;
+
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    sigfd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    wakefd[0] = wakefd[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epfd == -1 || sigfd == -1 || timerfd == -1 || wakefd[0] == -1) return -1;
+
+    struct { int fd; int kind; } sources[] = {
+        { input, EV_INPUT }, { sigfd, EV_RESIZE }, { timerfd, EV_TIMER }, { wakefd[0], EV_WAKE }
+    };
+    for (auto &s : sources) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = s.kind;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, s.fd, &ev) == -1) return -1;
+    }
+    #else
+    if (pipe(wakefd) == -1) return -1;
+    for (int j = 0; j < 2; j++) {
+        fcntl(wakefd[j], F_SETFL, O_NONBLOCK);
+        fcntl(wakefd[j], F_SETFD, FD_CLOEXEC);
+    }
+    sigpipe_fd = wakefd[1];
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onWinch;
+    sa.sa_flags = SA_RESTART;
+    if (sigaction(SIGWINCH, &sa, NULL) == -1) return -1;
+    #endif
+    return 0;
+}
+
+void EventLoop::setTimer(int ms) {
+    deadline_ms = ms > 0 ? nowMs() + ms : 0;
+
+    #ifdef __linux__
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = ms / 1000;
+    its.it_value.tv_nsec = (long)(ms % 1000) * 1000000;
+    timerfd_settime(timerfd, 0, &its, NULL);
+    #endif
+}
+
+/* Reports EV_OUTPUT once fd can take more bytes; off again when the
+ * writer has caught up. */
+void EventLoop::watchOutput(int fd, bool on) {
+    if (on == (output != -1)) return;
+    #ifdef __linux__
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLOUT;
+    ev.data.u32 = EV_OUTPUT;
+    if (epoll_ctl(epfd, on ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, on ? fd : output, &ev) == -1) return;
+    #endif
+    output = on ? fd : -1;
+}
+
+int EventLoop::wait() {
+    int ready = 0;
+
+    #ifdef __linux__
+    struct epoll_event evs[5];
+    int n = epoll_wait(epfd, evs, 5, -1);
+    if (n == -1) return 0;
+    for (int j = 0; j < n; j++) ready |= evs[j].data.u32;
+
+    if (ready & EV_RESIZE) {
+        struct signalfd_siginfo si;
+        while (read(sigfd, &si, sizeof(si)) > 0) {}
+    }
+    if (ready & EV_TIMER) {
+        drain(timerfd);
+        deadline_ms = 0;
+    }
+    if (ready & EV_WAKE) drain(wakefd[0]);
+    #else
+    int timeout = -1;
+    if (deadline_ms) {
+        long long left = deadline_ms - nowMs();
+        timeout = left > 0 ? (int)left : 0;
+    }
+
+    struct pollfd pfd[3] = { { input, POLLIN, 0 }, { wakefd[0], POLLIN, 0 }, { output, POLLOUT, 0 } };
+    int n = poll(pfd, output != -1 ? 3 : 2, timeout);
+    if (n == -1) return 0;
+    if (pfd[0].revents) ready |= EV_INPUT;
+    if (output != -1 && pfd[2].revents) ready |= EV_OUTPUT;
+    if (pfd[1].revents) {
+        char buf[64];
+        ssize_t got;
+        while ((got = read(wakefd[0], buf, sizeof(buf))) > 0) {
+            for (ssize_t j = 0; j < got; j++) ready |= buf[j] == 'w' ? EV_RESIZE : EV_WAKE;
+        }
+    }
+    if (deadline_ms && nowMs() >= deadline_ms) {
+        ready |= EV_TIMER;
+        deadline_ms = 0;
+    }
+    #endif
+    return ready;
+}
+
+void EventLoop::wake() {
+    #ifdef __linux__
+    uint64_t one = 1;
+    if (write(wakefd[1], &one, sizeof(one)) == -1) {}
+    #else
+    char c = 'j';
+    if (write(wakefd[1], &c, 1) == -1) {}
+    #endif
+}
+
+void EventLoop::submit(std::function<void()> job, std::function<void()> done) {
+    std::lock_guard<std::mutex> guard(lock);
+    jobs.push_back({ job, done });
+    if (!thread.joinable()) thread = std::thread(&EventLoop::worker, this);
+    cond.notify_one();
+}
+
+void EventLoop::worker() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        cond.wait(guard, [this] { return stopping || !jobs.empty(); });
+        if (stopping) return;
+
+        Job j = jobs.front();
+        jobs.pop_front();
+        guard.unlock();
+        j.job();
+        guard.lock();
+
+        if (j.done && !stopping) {
+            completions.push_back(j.done);
+            wake();
+        }
+    }
+}
+
+void EventLoop::runCompletions() {
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ready.swap(completions);
+    }
+    for (auto &done : ready) done();
+}
@@ -0,0 +1,57 @@
+// batch.hpp
+#pragma once
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "bulkio.hpp"
+
+enum batchOp {
+    BT_GOTO = 1,
+    BT_OFFSET,
+    BT_TOP,
+    BT_BOTTOM,
+    BT_UP,
+    BT_DOWN,
+    BT_LEFT,
+    BT_RIGHT,
+    BT_HOME,
+    BT_END,
+    BT_FIND,
+    BT_INSERT,
+    BT_NEWLINE,
+    BT_DELETE,
+    BT_DELETE_LINE,
+    BT_REPLACE,
+    BT_SAVE
+};
+
+struct BatchCommand {
+    int op;
+    int count;
+    uint64_t offset;
+    std::string text;
+    std::string with;
+};
+
+/* A script parsed once and applied to every file on its own Buffer, so
+ * files are edited in parallel without a terminal or any rendering. */
+class Batch {
+public:
+    int load(const char *path);
+    int run(int nfiles, char **files);
+
+private:
+    enum fileResult { FILE_SAVED, FILE_UNCHANGED, FILE_SKIPPED, FILE_FAILED };
+
+    int parse(const char *line, int lineno);
+    int apply(const char *file, BulkIO &io, std::string &err);
+
+    std::vector<BatchCommand> commands;
+    std::string script;
+};
+
+#endif // BATCH_HPP
@@ -0,0 +1,236 @@
+// buffer.hpp
+#pragma once
+#ifndef BUFFER_HPP
+#define BUFFER_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "session.hpp"
+#include "journal.hpp"
+#include "intern.hpp"
+#include "cold.hpp"
+#include "fenwick.hpp"
+#include "diff.hpp"
+#include "utf8.hpp"
+#include "bulkio.hpp"
+
+#define HL_HIGHLIGHT_NUMBERS (1<<0)
+#define HL_HIGHLIGHT_STRINGS (1<<1)
+#define HL_PARALLEL_MIN_ROWS 4096
+
+struct editorSyntax {
+    const char *filetype;
+    const char **filematch;
+    const char **keywords;
+    const char *single_line_comment_start;
+    const char *multiline_comment_start;
+    const char *multiline_comment_end;
+    int flags;
+};
+
+enum editorHighlight {
+    HL_NORMAL = 0,
+    HL_NUMBER,
+    HL_STRING,
+    HL_COMMENT,
+    HL_MLCOMMENT,
+    HL_KEYWORD1,
+    HL_KEYWORD2,
+    HL_MATCH
+};
+
+#define COLD_EDIT_MARGIN 256
+
+/* A row with an atom borrows chars from it, and render and hl as long as
+ * they point at the atom's copies; editing a row unshares it first.
+ * A cold row has no chars: its text is slot of a compressed block.
+ * width counts terminal columns; in an ASCII row it equals r_size and a
+ * render offset is a column. Other rows build cols on demand: for every
+ * byte of chars its column, then its offset in render. */
+typedef struct TextRow {
+    int idx;
+    int size;
+    int r_size;
+    int width;
+    bool ascii;
+    int slot;
+    char *chars;
+    char *render;
+    unsigned char *hl;
+    int *cols;
+    int hl_open_comment;
+    LineAtom *atom;
+    ColdBlock *block;
+} trow_;
+
+class Buffer;
+
+/* Whole lines cut or copied, as references to atoms of owner's line
+ * table: a copy of any size costs a pointer per line, not the text. */
+struct LineClip {
+    Buffer *owner = NULL;
+    std::vector<LineAtom *> atoms;
+
+    void clear();
+};
+
+/* Bytes one buffer holds, by what they are for. Slack is what malloc gave
+ * beyond the size asked for, or array capacity past the rows in use. */
+struct MemStats {
+    size_t rows;
+    size_t rows_slack;
+    size_t chars;
+    size_t chars_slack;
+    size_t render;
+    size_t hl;
+    size_t cols;
+    size_t shared;
+    size_t cold;
+    size_t index;
+};
+
+/* The text of one file together with its syntax state and cursor. It has
+ * no knowledge of the terminal, so it can be driven headless by tools. */
+class Buffer {
+public:
+    Buffer();
+    ~Buffer();
+
+    int cursor_x;
+    int cursor_y;
+    /* Row where a line selection starts, -1 when there is none. */
+    int mark_y;
+    int row_offset;
+    int col_offset;
+    int numrows;
+    trow_ *rows;
+    char *filename;
+    int dirty;
+    struct editorSyntax *syntax;
+    std::vector<uint64_t> offsets;
+    FileStamp stamp;
+
+    /* Headless users that never draw can skip syntax highlighting, and
+     * lend one BulkIO to every buffer they open instead of a new one per
+     * open and save. */
+    bool highlight;
+    BulkIO *io;
+    LineTable lines;
+    ColdStore cold;
+
+    /* Soft wrap: visual lines of every row at wrap_width columns, 0 = off. */
+    int wrap_width;
+    Fenwick<int> wraps;
+
+    /* Bytes of every row with its newline, as save writes them. */
+    Fenwick<int64_t> lengths;
+
+    /* Rows against the file on disk, while the diff gutter is shown. */
+    LineDiff diff;
+
+    /* Directory for session caches and journals; empty disables both. */
+    std::string dataDir;
+    Journal journal;
+    int recovered;
+    /* Another editor holds this file's journal; edits go unjournaled. */
+    bool journal_busy;
+
+    int editorOpen(const char *filename);
+    int64_t editorSave();
+    void editorClose();
+
+    void editorInsertRow(int at, const char *s, size_t len);
+    void editorInsertAtom(int at, LineAtom *atom);
+    void editorRowUnshare(trow_ *row);
+    unsigned char *editorRowOwnHl(trow_ *row);
+    void editorRowTouch(trow_ *row) { if (!row->chars) editorThawRow(row); }
+    const char *editorRowText(trow_ *row);
+    int editorFreeze(int keep_from, int keep_to);
+    size_t editorDerivedBytes() const;
+    void editorDropDerived(int keep_from, int keep_to);
+    void editorMemStats(MemStats &st);
+    void editorCompact(int keep_from, int keep_to);
+
+    void editorSetWrap(int width);
+    int editorRowWrapCount(const trow_ *row) const {
+        return row->width > wrap_width ? (row->width + wrap_width - 1) / wrap_width : 1;
+    }
+    int editorRowWrapSub(const trow_ *row, int rx) const;
+    int editorVisualLine(int at) const { return wraps.prefix(at); }
+    int editorVisualLines() const { return wraps.total(); }
+    int editorRowAtVisual(int v, int *sub) const;
+
+    uint64_t editorRowOffset(int at) const { return lengths.prefix(at); }
+    uint64_t editorCursorOffset() const { return editorRowOffset(cursor_y) + cursor_x; }
+    int editorRowAtOffset(uint64_t offset, int *col) const;
+    void editorGotoOffset(uint64_t offset);
+    static int parseOffset(const char *s, uint64_t *offset);
+    static int parseLine(const char *s, int *line);
+    void editorDelRow(int at);
+    void editorRowInsertChar(trow_ *row, int at, int c);
+    void editorRowDeleteChar(trow_ *row, int at);
+    void editorRowAppendString(trow_ *row, const char *s, size_t len);
+    void editorRowSetText(trow_ *row, const char *s, size_t len);
+    void editorInsertChar(int c);
+    void editorDelChar();
+    void editorInsertNewLine();
+
+    LineAtom *editorRowShare(trow_ *row);
+    void editorCopyRows(int from, int to, LineClip &clip);
+    void editorInsertAtoms(int at, const std::vector<LineAtom *> &atoms);
+    void editorPasteRows(int at, const LineClip &clip);
+    void editorDelRows(int from, int to);
+    bool editorMoveRows(int from, int to, int by);
+    void editorIndentRows(int from, int to, bool dedent);
+
+    void editorUpdateRow(trow_ *row);
+    void editorUpdateRender(trow_ *row);
+    void editorRowPrepare(trow_ *row);
+    int editorRowLexState(trow_ *row, int in_comment);
+    int editorRowCxToRx(trow_ *row, int cx);
+    int editorRowRxToCx(trow_ *row, int rx);
+    int editorRowRenderToCx(trow_ *row, int at);
+    int editorRowNextChar(trow_ *row, int cx);
+    int editorRowPrevChar(trow_ *row, int cx);
+    int editorRowCharStart(trow_ *row, int cx);
+    int editorFindNext(const char *query, int last_match, int direction, int *match_rx);
+    void editorDrawRow(std::string &ab, int at, int col_offset, int cols);
+
+    void editorSelectSyntaxHighlight();
+    struct editorSyntax *editorFindSyntax();
+    void editorUpdateSyntax(trow_ *row);
+    void editorUpdateSyntaxRange(int from, int to);
+    int editorHighlightRow(trow_ *row, int in_comment);
+    int editorLexRow(const trow_ *row, unsigned char *hl, int in_comment);
+    void editorUpdateSyntaxAll();
+    int editorSyntaxToColor(int hl);
+    static int is_separator(int c);
+
+    void editorStoreSession();
+
+    uint64_t editorRowHash(int at);
+    void editorDiffStart(std::vector<uint64_t> &&base);
+    void editorDiffUpdate();
+
+private:
+    Buffer(const Buffer &);
+    Buffer &operator=(const Buffer &);
+
+    void editorFreeRow(trow_ *row);
+    int *editorRowCols(trow_ *row);
+    int editorWriteRows(int fd);
+    void editorThawRow(trow_ *row);
+    void editorNoteEdit(int at);
+    bool editorNearEdit(int at);
+
+    int edit_sites[COLD_EDIT_SITES];
+    int next_edit_site;
+    int editorOpenSession(const char *filename);
+    void editorOpenJournal();
+    void editorJournalReplay(const JournalRecord &rec, const char *s);
+};
+
+#endif // BUFFER_HPP
@@ -0,0 +1,75 @@
+// bulkio.hpp
+#pragma once
+#ifndef BULKIO_HPP
+#define BULKIO_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#define BULKIO_CHUNK (1 << 20)
+#define BULKIO_DEPTH 4
+
+/* Sequential whole-file I/O through a ring of BULKIO_DEPTH chunks. With
+ * io_uring the chunks are registered buffers and up to BULKIO_DEPTH reads
+ * or writes stay queued while the caller works on another chunk; without
+ * it (old kernel, seccomp, memlock limit) each chunk is a plain pread or
+ * pwrite done in place. One BulkIO can serve file after file: the ring
+ * and the chunks are set up once. */
+class BulkIO {
+public:
+    explicit BulkIO(bool use_uring);
+    ~BulkIO();
+    bool uring() const { return ring_fd != -1; }
+
+    /* The file in order, one chunk per call: its length, 0 at the end or
+     * -1 with errno set. The data stays valid until the next call. */
+    int startRead(int fd);
+    ssize_t next(const char **data);
+
+    /* Fill buffer() with up to BULKIO_CHUNK bytes and put() them at the
+     * next offset; finish() waits for the queue and reports the first
+     * failure. */
+    void startWrite(int fd, uint64_t total);
+    char *buffer() { return chunk(current); }
+    int put(size_t len);
+    int finish();
+
+private:
+    int setupRing();
+    void submit(int slot, bool write, uint64_t offset, size_t len);
+    int reap();
+    void drain();
+    void reset();
+    char *chunk(int slot) { return bufs + (size_t)slot * BULKIO_CHUNK; }
+
+    bool want_uring;
+    int fd;
+    bool regular;
+    uint64_t size;
+    uint64_t offset;
+    int queued;
+    int current;
+    int error;
+    char *bufs;
+
+    int ring_fd;
+    void *sq_ptr;
+    void *cq_ptr;
+    size_t sq_len;
+    size_t cq_len;
+    struct io_uring_sqe *sqes;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    /* Per slot: bytes asked for, bytes done and the file offset. */
+    struct Slot {
+        bool busy;
+        size_t len;
+        ssize_t done;
+        uint64_t offset;
+    } slots[BULKIO_DEPTH];
+};
+
+#endif // BULKIO_HPP
@@ -0,0 +1,62 @@
+// cold.hpp
+#pragma once
+#ifndef COLD_HPP
+#define COLD_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#define COLD_BLOCK_ROWS 256
+#define COLD_MIN_ROWS 32
+#define COLD_EDIT_SITES 8
+
+/* The text of up to COLD_BLOCK_ROWS neighbouring rows, packed end to end
+ * and LZ-compressed. live counts the rows still stored here; the block is
+ * freed when the last one is thawed or deleted. */
+struct ColdBlock {
+    ColdBlock *prev;
+    ColdBlock *next;
+    std::string data;
+    uint32_t raw_len;
+    int live;
+    std::vector<uint32_t> starts;
+};
+
+struct ColdStats {
+    uint64_t rows;
+    uint64_t blocks;
+    uint64_t raw_bytes;
+    uint64_t packed_bytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t thaws;
+};
+
+/* Owns a buffer's cold blocks and keeps the last one decompressed, so a
+ * screenful of rows from one block costs a single decompression. */
+class ColdStore {
+public:
+    ColdStore();
+    ~ColdStore();
+
+    ColdBlock *pack(const std::string &raw, const std::vector<uint32_t> &starts);
+    const char *peek(ColdBlock *block);
+    void drop(ColdBlock *block);
+    void clear();
+    void trim();
+    size_t bytes() const { return stats.packed_bytes + cache.capacity(); }
+
+    ColdStats stats;
+
+private:
+    ColdStore(const ColdStore &);
+    ColdStore &operator=(const ColdStore &);
+
+    ColdBlock *head;
+    ColdBlock *cached;
+    std::string cache;
+};
+
+#endif // COLD_HPP
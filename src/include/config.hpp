@@ -10,6 +10,13 @@
 struct EditorConfig {
     int tab_stop = 8;
     int quit_times = 3;
+    int session_cache = 0;
+    int journal = 1;
+    int intern_lines = 0;
+    int rss_target_mb = 0;
+    int soft_wrap = 0;
+    int cache_budget_mb = 0;
+    int io_uring = 1;
     int hl_comment = 90;
     int hl_mlcomment = 90;
     int hl_keyword1 = 93;
@@ -23,15 +30,36 @@ class Config {
 public:
     EditorConfig config;
     int loadConfig(const std::string &path);
+    static std::string defaultDir();
 };
 
-int Config::loadConfig(const std::string &path) {
+extern Config cfg;
+
+/* Where config.conf, sessions and journals live; empty without HOME. */
+inline std::string Config::defaultDir() {
+    const char *home = std::getenv("HOME");
+    if (!home) return "";
+    #ifdef __APPLE__
+    return std::string(home) + "/Library/Application Support/edi";
+    #else
+    return std::string(home) + "/.config/edi";
+    #endif
+}
+
+inline int Config::loadConfig(const std::string &path) {
     FILE *f = fopen(path.c_str(), "r");
     if (!f) return 1;
     char line[512];
     while (fgets(line, sizeof(line), f)) {
         if (strncmp(line, "tab_stop=", 9) == 0) config.tab_stop = atoi(line + 9);
         else if (strncmp(line, "quit_times=", 11) == 0) config.quit_times = atoi(line + 11);
+        else if (strncmp(line, "session_cache=", 14) == 0) config.session_cache = atoi(line + 14);
+        else if (strncmp(line, "journal=", 8) == 0) config.journal = atoi(line + 8);
+        else if (strncmp(line, "intern_lines=", 13) == 0) config.intern_lines = atoi(line + 13);
+        else if (strncmp(line, "rss_target_mb=", 14) == 0) config.rss_target_mb = atoi(line + 14);
+        else if (strncmp(line, "soft_wrap=", 10) == 0) config.soft_wrap = atoi(line + 10);
+        else if (strncmp(line, "cache_budget_mb=", 16) == 0) config.cache_budget_mb = atoi(line + 16);
+        else if (strncmp(line, "io_uring=", 9) == 0) config.io_uring = atoi(line + 9);
         else if (strncmp(line, "hl_comment=", 11) == 0) config.hl_comment = atoi(line + 11);
         else if (strncmp(line, "hl_mlcomment=", 13) == 0) config.hl_mlcomment = atoi(line + 13);
         else if (strncmp(line, "hl_keyword1=", 12) == 0) config.hl_keyword1 = atoi(line + 12);
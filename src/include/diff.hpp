@@ -0,0 +1,74 @@
+// diff.hpp
+#pragma once
+#ifndef DIFF_HPP
+#define DIFF_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <functional>
+
+#define DIFF_MAX_EDITS 1024
+#define DIFF_MAX_WINDOWS 64
+
+enum diffKind {
+    DIFF_SAME = 0,
+    DIFF_ADDED,
+    DIFF_CHANGED
+};
+
+/* Aligns two runs of line hashes: match[i] is the line of b equal to line
+ * i of a, or -1. Common ends are stripped, lines unique to both sides are
+ * anchored patience style and the gaps between anchors go to Myers; a gap
+ * needing more than DIFF_MAX_EDITS edits is left unmatched. */
+void diffLines(const uint64_t *a, int n, const uint64_t *b, int m, int *match);
+
+/* Hashes of the lines of a file on disk, split the way editorOpen does. */
+int diffHashFile(const char *path, std::vector<uint64_t> &hashes);
+
+/* The difference of a buffer against its base, kept per buffer row. Row
+ * edits only record dirty windows; update() re-diffs each of them between
+ * the nearest unchanged matched rows instead of the whole file. */
+class LineDiff {
+public:
+    LineDiff();
+
+    bool active() const { return on; }
+    void start(std::vector<uint64_t> &&base_hashes, const std::vector<uint64_t> &rows);
+    void stop();
+    void rebase(const std::vector<uint64_t> &rows);
+
+    void rowInserted(int at);
+    void rowDeleted(int at);
+    void rowChanged(int at);
+    void rowsInserted(int at, int n);
+    void rowsDeleted(int at, int n);
+    bool pending() const { return !dirty.empty(); }
+
+    void update(const std::function<uint64_t(int)> &hashRow);
+
+    size_t bytes() const;
+    void shrink();
+
+    int kind(int at) const { return marks[at] & 3; }
+    int deletedAbove(int at) const { return marks[at] >> 2; }
+
+    int added;
+    int changed;
+    int deleted;
+    int tail_deleted;
+
+private:
+    void relabel(int from, int to);
+    void setMark(int at, int kind, int removed);
+    void touch(int from, int to);
+    void shift(int at, int by);
+
+    bool on;
+    std::vector<uint64_t> base;
+    std::vector<int> match;
+    std::vector<uint32_t> marks;
+    std::vector<std::pair<int, int>> dirty;
+};
+
+#endif // DIFF_HPP
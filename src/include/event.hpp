@@ -0,0 +1,65 @@
+// event.hpp
+#pragma once
+#ifndef EVENT_HPP
+#define EVENT_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum eventKind {
+    EV_INPUT = 1 << 0,
+    EV_RESIZE = 1 << 1,
+    EV_TIMER = 1 << 2,
+    EV_WAKE = 1 << 3,
+    EV_OUTPUT = 1 << 4
+};
+
+/* One place the editor sleeps in: terminal input, SIGWINCH, a one-shot
+ * timer, completions posted by the background worker and, while a frame
+ * is stuck, the terminal becoming writable again. On Linux this is
+ * epoll over signalfd, timerfd and eventfd; elsewhere poll and a self-pipe. */
+class EventLoop {
+public:
+    EventLoop();
+    ~EventLoop();
+
+    int open(int input_fd);
+    int wait();
+    void setTimer(int ms);
+    void watchOutput(int fd, bool on);
+
+    /* Runs job on the worker thread, then done on the loop thread the next
+     * time runCompletions is called. */
+    void submit(std::function<void()> job, std::function<void()> done);
+    void runCompletions();
+
+private:
+    struct Job {
+        std::function<void()> job;
+        std::function<void()> done;
+    };
+
+    void worker();
+    void wake();
+
+    int input;
+    int output;
+    int epfd;
+    int sigfd;
+    int timerfd;
+    int wakefd[2];
+    long long deadline_ms;
+
+    std::mutex lock;
+    std::condition_variable cond;
+    std::deque<Job> jobs;
+    std::vector<std::function<void()>> completions;
+    std::thread thread;
+    bool stopping;
+};
+
+#endif // EVENT_HPP
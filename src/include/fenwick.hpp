@@ -0,0 +1,277 @@
+// fenwick.hpp
+#pragma once
+#ifndef FENWICK_HPP
+#define FENWICK_HPP
+
+#include <stddef.h>
+#include <algorithm>
+#include <vector>
+
+#define FENWICK_BLOCK 256
+
+/* A plain Fenwick tree over m values: O(log m) add, prefix and search. */
+template <typename T>
+struct FenwickTree {
+    std::vector<T> tree = std::vector<T>(1, 0);
+
+    size_t size() const { return tree.size() - 1; }
+
+    void build(const T *v, size_t m) {
+        tree.assign(m + 1, 0);
+        for (size_t i = 1; i <= m; i++) {
+            tree[i] += v[i - 1];
+            size_t j = i + (i & -i);
+            if (j <= m) tree[j] += tree[i];
+        }
+    }
+
+    void add(size_t i, T delta) {
+        for (size_t j = i + 1; j < tree.size(); j += j & -j) tree[j] += delta;
+    }
+
+    void push_back(T v) {
+        size_t i = tree.size();
+        tree.push_back(v + prefix(i - 1) - prefix(i - (i & -i)));
+    }
+
+    /* Sum of the first i values. */
+    T prefix(size_t i) const {
+        T sum = 0;
+        for (; i > 0; i -= i & -i) sum += tree[i];
+        return sum;
+    }
+
+    /* The last index i with prefix(i) <= pos, and pos - prefix(i). */
+    size_t find(T pos, T *rest) const {
+        size_t i = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (i + step < tree.size() && tree[i + step] <= pos) {
+                i += step;
+                pos -= tree[i];
+            }
+        }
+        *rest = pos;
+        return i;
+    }
+};
+
+/* Prefix sums over per-row values with O(log n) update, prefix and search.
+ * The values are kept in blocks of FENWICK_BLOCK to 2 * FENWICK_BLOCK, each
+ * with a tree of its own, under trees of the block sizes and block sums:
+ * inserting or erasing a row costs O(FENWICK_BLOCK + log n) wherever it is,
+ * and only splitting or dropping a block, once in FENWICK_BLOCK edits, or a
+ * range operation, rebuilds the trees over the blocks. */
+template <typename T>
+class Fenwick {
+public:
+    size_t size() const { return n; }
+    T get(size_t i) const {
+        size_t k;
+        size_t b = locate(i, &k);
+        return blocks[b].vals[k];
+    }
+    T total() const { return sums.prefix(sums.size()); }
+
+    size_t bytes() const {
+        size_t sum = blocks.capacity() * sizeof(Block) +
+            counts.tree.capacity() * sizeof(size_t) + sums.tree.capacity() * sizeof(T);
+        for (const Block &bl : blocks) sum += (bl.vals.capacity() + bl.tree.tree.capacity()) * sizeof(T);
+        return sum;
+    }
+
+    void shrink() {
+        for (Block &bl : blocks) {
+            bl.vals.shrink_to_fit();
+            bl.tree.tree.shrink_to_fit();
+        }
+        blocks.shrink_to_fit();
+    }
+
+    void clear() {
+        blocks.clear();
+        n = 0;
+        rebuildTop();
+    }
+
+    void assign(std::vector<T> &&v) {
+        blocks.clear();
+        appendBlocks(blocks.end(), v.data(), v.size());
+        n = v.size();
+        rebuildTop();
+        std::vector<T>().swap(v);
+    }
+
+    void set(size_t i, T v) {
+        size_t k;
+        size_t b = locate(i, &k);
+        Block &bl = blocks[b];
+        T delta = v - bl.vals[k];
+        if (delta == 0) return;
+        bl.vals[k] = v;
+        bl.tree.add(k, delta);
+        sums.add(b, delta);
+    }
+
+    void push_back(T v) { insert(n, v); }
+
+    void insert(size_t i, T v) {
+        if (blocks.empty()) {
+            blocks.emplace_back();
+            rebuildTop();
+        }
+        size_t k;
+        size_t b = i == n ? blocks.size() - 1 : locate(i, &k);
+        Block &bl = blocks[b];
+        if (i == n) {
+            bl.vals.push_back(v);
+            bl.tree.push_back(v);
+        } else {
+            bl.vals.insert(bl.vals.begin() + k, v);
+            bl.tree.build(bl.vals.data(), bl.vals.size());
+        }
+        n++;
+        counts.add(b, 1);
+        sums.add(b, v);
+        if (bl.vals.size() >= 2 * FENWICK_BLOCK) split(b);
+    }
+
+    void erase(size_t i) {
+        size_t k;
+        size_t b = locate(i, &k);
+        Block &bl = blocks[b];
+        T v = bl.vals[k];
+        bl.vals.erase(bl.vals.begin() + k);
+        n--;
+        if (bl.vals.size() < FENWICK_BLOCK / 4 && blocks.size() > 1) {
+            merge(b);
+            return;
+        }
+        bl.tree.build(bl.vals.data(), bl.vals.size());
+        counts.add(b, (size_t)-1);
+        sums.add(b, -v);
+    }
+
+    void insert(size_t i, const std::vector<T> &v) {
+        if (v.empty()) return;
+        if (blocks.empty() || i == n) {
+            appendBlocks(blocks.end(), v.data(), v.size());
+        } else {
+            /* The block holding i is cut in two around the new values. */
+            size_t k;
+            size_t b = locate(i, &k);
+            std::vector<T> joined(blocks[b].vals.begin(), blocks[b].vals.begin() + k);
+            joined.insert(joined.end(), v.begin(), v.end());
+            joined.insert(joined.end(), blocks[b].vals.begin() + k, blocks[b].vals.end());
+            blocks.erase(blocks.begin() + b);
+            appendBlocks(blocks.begin() + b, joined.data(), joined.size());
+        }
+        n += v.size();
+        rebuildTop();
+    }
+
+    void erase(size_t i, size_t count) {
+        if (count == 0) return;
+        size_t k;
+        size_t b = locate(i, &k);
+        size_t first = b;
+        while (count > 0) {
+            std::vector<T> &vals = blocks[b].vals;
+            size_t take = std::min(count, vals.size() - k);
+            vals.erase(vals.begin() + k, vals.begin() + k + take);
+            blocks[b].tree.build(vals.data(), vals.size());
+            n -= take;
+            count -= take;
+            b++;
+            k = 0;
+        }
+        /* Emptied blocks go; a small leftover joins its neighbour. */
+        blocks.erase(std::remove_if(blocks.begin() + first, blocks.begin() + b,
+            [](const Block &bl) { return bl.vals.empty(); }), blocks.begin() + b);
+        rebuildTop();
+        if (first + 1 < blocks.size() && blocks[first + 1].vals.size() < FENWICK_BLOCK / 4) merge(first + 1);
+        if (first < blocks.size() && blocks[first].vals.size() < FENWICK_BLOCK / 4 && blocks.size() > 1) merge(first);
+    }
+
+    /* Sum of the first i values. */
+    T prefix(size_t i) const {
+        if (i >= n) return total();
+        size_t k;
+        size_t b = locate(i, &k);
+        return sums.prefix(b) + blocks[b].tree.prefix(k);
+    }
+
+    /* The index whose range [prefix(i), prefix(i + 1)) holds pos, for
+     * positive values; size() when pos is past the end. */
+    size_t find(T pos) const {
+        T rest;
+        size_t b = sums.find(pos, &rest);
+        if (b >= blocks.size()) return n;
+        return counts.prefix(b) + blocks[b].tree.find(rest, &rest);
+    }
+
+private:
+    struct Block {
+        std::vector<T> vals;
+        FenwickTree<T> tree;
+    };
+
+    /* The block holding value i, and i's place in it. */
+    size_t locate(size_t i, size_t *k) const {
+        return counts.find(i, k);
+    }
+
+    /* Cuts m values into even blocks of at most FENWICK_BLOCK, inserted at
+     * pos: no short block is left over to be merged again at once. */
+    void appendBlocks(typename std::vector<Block>::iterator pos, const T *v, size_t m) {
+        size_t nb = (m + FENWICK_BLOCK - 1) / FENWICK_BLOCK;
+        size_t at = pos - blocks.begin();
+        blocks.insert(pos, nb, Block());
+        size_t from = 0;
+        for (size_t j = 0; j < nb; j++) {
+            Block &bl = blocks[at + j];
+            size_t len = m / nb + (j < m % nb);
+            bl.vals.assign(v + from, v + from + len);
+            bl.tree.build(bl.vals.data(), len);
+            from += len;
+        }
+    }
+
+    void split(size_t b) {
+        std::vector<T> vals;
+        vals.swap(blocks[b].vals);
+        blocks.erase(blocks.begin() + b);
+        appendBlocks(blocks.begin() + b, vals.data(), vals.size());
+        rebuildTop();
+    }
+
+    /* Joins block b with a neighbour, splitting again if that is too big. */
+    void merge(size_t b) {
+        size_t left = b > 0 ? b - 1 : b;
+        std::vector<T> vals;
+        vals.swap(blocks[left].vals);
+        vals.insert(vals.end(), blocks[left + 1].vals.begin(), blocks[left + 1].vals.end());
+        blocks.erase(blocks.begin() + left, blocks.begin() + left + 2);
+        if (!vals.empty()) appendBlocks(blocks.begin() + left, vals.data(), vals.size());
+        rebuildTop();
+    }
+
+    void rebuildTop() {
+        std::vector<size_t> c(blocks.size());
+        std::vector<T> s(blocks.size());
+        for (size_t b = 0; b < blocks.size(); b++) {
+            c[b] = blocks[b].vals.size();
+            s[b] = blocks[b].tree.prefix(c[b]);
+        }
+        counts.build(c.data(), c.size());
+        sums.build(s.data(), s.size());
+    }
+
+    std::vector<Block> blocks;
+    FenwickTree<size_t> counts;
+    FenwickTree<T> sums;
+    size_t n = 0;
+};
+
+#endif // FENWICK_HPP
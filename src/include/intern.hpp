@@ -0,0 +1,57 @@
+// intern.hpp
+#pragma once
+#ifndef INTERN_HPP
+#define INTERN_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+
+/* Immutable contents shared by every row with the same text. render is
+ * built once on the main thread; hl is the highlight for a row entered
+ * outside of a comment, with the lexer state at its end stored in
+ * hl[r_size]. It is published with a CAS so parallel lexing can fill it. */
+struct LineAtom {
+    LineAtom *next;
+    uint64_t hash;
+    int refs;
+    int size;
+    int r_size;
+    int width;
+    bool ascii;
+    char *render;
+    std::atomic<unsigned char *> hl;
+    char chars[1];
+};
+
+/* Hash-consing table of one buffer's lines; it is only touched from the
+ * thread that edits the buffer. */
+class LineTable {
+public:
+    LineTable();
+    ~LineTable();
+
+    LineAtom *intern(const char *s, size_t len);
+    void acquire(LineAtom *atom) { atom->refs++; }
+    void release(LineAtom *atom);
+    void clearHighlight();
+
+    size_t atoms() const { return count; }
+    size_t bytes() const;
+    uint64_t lookups;
+    uint64_t hits;
+
+private:
+    LineTable(const LineTable &);
+    LineTable &operator=(const LineTable &);
+
+    void grow();
+
+    std::vector<LineAtom *> buckets;
+    size_t count;
+};
+
+uint64_t lineHash(const char *s, size_t len);
+
+#endif // INTERN_HPP
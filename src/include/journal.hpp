@@ -0,0 +1,74 @@
+// journal.hpp
+#pragma once
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <stdint.h>
+#include <time.h>
+#include <string>
+#include <functional>
+
+#include "session.hpp"
+
+#define JOURNAL_MAGIC "EDIJ"
+#define JOURNAL_VERSION 2
+#define JOURNAL_FLUSH_BYTES (64 * 1024)
+#define JOURNAL_SYNC_SECONDS 1
+
+enum journalOp {
+    JR_INSERT_CHAR = 1,
+    JR_DELETE_CHAR,
+    JR_INSERT_ROW,
+    JR_DELETE_ROW,
+    JR_APPEND_STRING,
+    JR_TRUNCATE_ROW,
+    JR_SET_ROW
+};
+
+/* Every buffer mutation is one record followed by len payload bytes.
+ * crc is the CRC-32 of the record, with crc itself zero, and the payload. */
+struct JournalRecord {
+    uint8_t op;
+    uint8_t pad[3];
+    int32_t row;
+    int32_t at;
+    uint32_t len;
+    uint32_t crc;
+};
+
+struct JournalHeader {
+    char magic[4];
+    uint32_t version;
+    FileStamp stamp;
+    uint32_t path_len;
+    uint32_t pad;
+};
+
+class Journal {
+public:
+    Journal();
+    ~Journal();
+
+    int open(const std::string &dir, const char *filename, const FileStamp &stamp,
+             std::function<void(const JournalRecord &, const char *)> replay);
+    void record(int op, int row, int at, const char *s, uint32_t len);
+    void commit();
+    void reset(const FileStamp &stamp);
+    void discard();
+    bool active() const { return fd != -1; }
+    bool needsSync() const { return fd != -1 && unsynced; }
+    int detachSync();
+
+private:
+    int writeHeader(const FileStamp &stamp);
+    void flush();
+
+    int fd;
+    std::string path;
+    std::string real;
+    std::string pending;
+    time_t last_sync;
+    bool unsynced;
+};
+
+#endif // JOURNAL_HPP
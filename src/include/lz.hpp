@@ -0,0 +1,18 @@
+// lz.hpp
+#pragma once
+#ifndef LZ_HPP
+#define LZ_HPP
+
+#include <stddef.h>
+#include <string>
+
+/* A small LZ77 byte codec in the spirit of LZ4: sequences of a token byte
+ * (literal length << 4 | match length - 4), extra length bytes, literals
+ * and a 16-bit little-endian match offset. The last sequence has no match. */
+#define LZ_MIN_MATCH 4
+#define LZ_HASH_BITS 12
+
+void lzCompress(const char *src, size_t len, std::string &out);
+int lzDecompress(const char *src, size_t len, char *dst, size_t dst_len);
+
+#endif // LZ_HPP
@@ -0,0 +1,64 @@
+// output.hpp
+#pragma once
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+#define OUTPUT_SYNC_BEGIN "\x1b[?2026h"
+#define OUTPUT_SYNC_END "\x1b[?2026l"
+#define OUTPUT_FINISH_MS 500
+
+struct OutputStats {
+    uint64_t frames;
+    uint64_t merged;        /* frames that replaced unsent output */
+    uint64_t stalls;        /* writes refused with EAGAIN */
+    uint64_t bytes;
+    uint64_t busy_ns;       /* time from a frame's submit to its last byte */
+};
+
+/* Frames to the terminal through a non-blocking description of it of its
+ * own, so stdin keeps its blocking mode. A frame the terminal cannot take
+ * at once stays queued; the next frame replaces whatever of it has not been
+ * sent yet, so a slow link only ever catches up on the newest screen. */
+class TermOutput {
+public:
+    TermOutput();
+    ~TermOutput();
+
+    int open(int out_fd);
+    int fd() const { return out; }
+
+    /* Queues a complete frame and writes what the terminal takes now. */
+    void frame(const std::string &ab);
+    /* Writes more of the queued frame; true once it is all out. */
+    bool flush();
+    bool pending() const { return sent < buf.size(); }
+    bool blocked() const { return stalled; }
+    /* The event loop saw the terminal writable again. */
+    void resume() { stalled = false; }
+    /* Before leaving the screen: ends the sequence in progress and the
+     * synchronized update, waiting a little for a stuck terminal. */
+    void finish();
+
+    /* Bytes per second the terminal took while a frame was in flight. */
+    double throughput() const;
+
+    OutputStats stats;
+
+private:
+    size_t writeSome(const char *s, size_t len);
+    size_t safeCut() const;
+    void idle();
+
+    int out;
+    bool own;
+    bool stalled;
+    std::string buf;
+    size_t sent;
+    uint64_t busy_since;
+};
+
+#endif // OUTPUT_HPP
@@ -0,0 +1,88 @@
+// perf.hpp
+#pragma once
+#ifndef PERF_HPP
+#define PERF_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PERF_WINDOW 128
+#define PERF_EVENTS (1 << 16)
+
+enum perfPhase {
+    PERF_READKEY = 0,
+    PERF_DISPATCH,
+    PERF_SCROLL,
+    PERF_HIGHLIGHT,
+    PERF_DRAW,
+    PERF_WRITE,
+    PERF_PHASES
+};
+
+struct PerfEvent {
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    uint64_t allocs;
+    uint64_t bytes;
+    int phase;
+};
+
+/* Main-loop phase timers. Everything is a no-op behind one branch while
+ * disabled; when enabled, every phase also counts the allocations made
+ * inside it and keeps a rolling window for the status-bar overlay. */
+class Perf {
+public:
+    Perf();
+
+    bool enabled;
+
+    void enable(bool on);
+    void end(int phase, uint64_t start_ns, uint64_t start_allocs, uint64_t bytes);
+    void overlay(char *buf, size_t len);
+    int dumpTrace(const char *path);
+
+    uint64_t samples[PERF_PHASES][PERF_WINDOW];
+    uint64_t bytes[PERF_PHASES];
+    uint64_t allocs[PERF_PHASES];
+    int counts[PERF_PHASES];
+
+private:
+    PerfEvent *events;
+    size_t nevents;
+    size_t next_event;
+    uint64_t origin_ns;
+};
+
+extern Perf perf;
+
+uint64_t perfNow();
+uint64_t perfAllocCount();
+void perfCountAllocs(bool on);
+void perfNoteAlloc();
+/* Whether the allocation hooks are linked in; they report it once, at
+ * startup, by passing true. */
+bool perfAllocsHooked(bool hooked = false);
+uint64_t perfRss();
+
+class PerfScope {
+public:
+    PerfScope(int phase) : phase(phase), start_ns(0), start_allocs(0), bytes(0) {
+        if (!perf.enabled) return;
+        start_allocs = perfAllocCount();
+        start_ns = perfNow();
+    }
+    ~PerfScope() {
+        if (start_ns) perf.end(phase, start_ns, start_allocs, bytes);
+    }
+
+    int phase;
+    uint64_t start_ns;
+    uint64_t start_allocs;
+    uint64_t bytes;
+};
+
+#define PERF_SCOPE_NAME2(line) perf_scope_##line
+#define PERF_SCOPE_NAME(line) PERF_SCOPE_NAME2(line)
+#define PERF_SCOPE(phase) PerfScope PERF_SCOPE_NAME(__LINE__)(phase)
+
+#endif // PERF_HPP
@@ -0,0 +1,80 @@
+// session.hpp
+#pragma once
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#define SESSION_MAGIC "EDIS"
+#define SESSION_VERSION 1
+
+/* Identity of a file on disk: a cache or journal built for one stamp is
+ * only valid while the file still has the same size and mtime. */
+struct FileStamp {
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+};
+
+int fileStamp(const char *path, FileStamp *st);
+bool fileStampEqual(const FileStamp &a, const FileStamp &b);
+uint64_t pathHash(const char *path);
+std::string sidecarPath(const std::string &dir, const char *path, const char *ext);
+
+/* On-disk layout, in host byte order:
+ *   SessionHeader
+ *   path bytes, padded to 8
+ *   uint64_t offsets[numrows]       byte offset of every line in the file
+ *   uint32_t lengths[numrows]       line length without the line ending
+ *   uint32_t r_sizes[numrows]       rendered width of the line
+ *   uint8_t  open_comment[numrows]  lexer state at the end of the line */
+struct SessionHeader {
+    char magic[4];
+    uint32_t version;
+    FileStamp stamp;
+    uint64_t numrows;
+    char filetype[16];
+    int32_t tab_stop;
+    int32_t cursor_x;
+    int32_t cursor_y;
+    int32_t row_offset;
+    int32_t col_offset;
+    uint32_t path_len;
+};
+
+struct SessionState {
+    int tab_stop;
+    int cursor_x;
+    int cursor_y;
+    int row_offset;
+    int col_offset;
+};
+
+class Session {
+public:
+    Session();
+    ~Session();
+
+    int load(const std::string &dir, const char *filename, const char *filetype, int tab_stop);
+    static int store(const std::string &dir, const char *filename, const char *filetype,
+                     const SessionState &state, const std::vector<uint64_t> &offsets,
+                     const std::vector<uint32_t> &lengths, const std::vector<uint32_t> &r_sizes,
+                     const std::vector<uint8_t> &open_comment);
+
+    const SessionHeader *header;
+    const uint64_t *offsets;
+    const uint32_t *lengths;
+    const uint32_t *r_sizes;
+    const uint8_t *open_comment;
+
+private:
+    void close();
+
+    void *map;
+    size_t map_len;
+};
+
+#endif // SESSION_HPP
@@ -3,10 +3,13 @@
 #ifndef TERM_HPP
 #define TERM_HPP
 
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <string>
 #include <functional>
+#include <memory>
+#include <vector>
 #include <stdio.h>
 #include <errno.h>
 #include <unistd.h>
@@ -21,6 +24,14 @@
 #include <filesystem>
 #include <fstream>
 
+#include "buffer.hpp"
+#include "event.hpp"
+#include "output.hpp"
+
+#define STATUS_MSG_SECONDS 7
+#define RECLAIM_IDLE_MS 1000
+#define DIFF_GUTTER 2
+
 class Term {
 public:
     Term();
@@ -33,35 +44,38 @@ public:
     void editorSetStatusMessage(const char *fmt, ...);
     
 private:
-    typedef struct TextRow {
-        int idx;
-        int size;
-        int r_size;
-        char *chars;
-        char *render;
-        unsigned char *hl;
-        int hl_open_comment;
-    } trow_;
-
     struct OrigTermCfg {
         struct termios orig_term;
         int screen_rows;
         int screen_cols;
-        int cursor_x;
-        int cursor_y;
         int r_x;
-        int row_offset;
-        int col_offset;
-        int numrows;
-        trow_ *row;
-        char *filename;
-        char statusMsg[80];
+        int wrap_sub;
+        int cursor_sy;
+        int cursor_sx;
+        char statusMsg[192];
         time_t statusMsg_time;
-        int dirty;
-        struct editorSyntax *syntax;
     } _C;
 
+    /* Open files; a slot that was never shown holds only its name and is
+     * read on the first switch to it. */
+    struct BufferSlot {
+        std::unique_ptr<Buffer> buffer;
+        bool loaded;
+        uint64_t last_used;
+        size_t derived;
+    };
+    std::vector<BufferSlot> buffers;
+    size_t current;
+    uint64_t use_clock;
+    Buffer *_B;
+    EventLoop loop;
+    TermOutput output;
+    bool redraw_owed;
+    bool reclaim_pending;
+    bool diff_loading;
+    LineClip clip;
     std::string abuf;
+    std::filesystem::path configDir;
 
     enum editorKey {
         BACKSPACE = 127,
@@ -73,52 +87,50 @@ private:
         CTRL_ARROW_RIGHT,
         CTRL_ARROW_UP,
         CTRL_ARROW_DOWN,
+        ALT_ARROW_UP,
+        ALT_ARROW_DOWN,
+        SHIFT_TAB,
         DEL_KEY
     };
 
-    enum editorHighlight {
-        HL_NORMAL = 0,
-        HL_NUMBER,
-        HL_STRING,
-        HL_COMMENT,
-        HL_MLCOMMENT,
-        HL_KEYWORD1,
-        HL_KEYWORD2,
-        HL_MATCH
-    };
-
     void editorMoveCursor(int key);
+    void editorMoveVisual(int v);
+    void editorSetWrap(bool on);
+    int editorCursorVisual();
+    int editorGutter() { return _B->diff.active() ? DIFF_GUTTER : 0; }
+    int editorTextCols() { return _C.screen_cols - editorGutter(); }
+    void editorDrawGutter(std::string &ab, int at);
+    void editorToggleDiff();
+    bool editorSelection(int *from, int *to);
+    void editorRangeCommand(int key);
     void enableRawMode();
     void disableRawMode();
     void die(const char *msg);
     int editorReadKey();
+    void editorWaitInput();
+    void editorFlushOutput(bool input);
+    void editorArmTimer();
+    void editorResize();
+    void editorSyncJournal();
+    void editorReclaim();
+    void editorMemoryReport();
+    void editorCompact();
+    size_t editorAddBuffer(const char *filename);
+    void editorSwitchBuffer(size_t at);
+    void editorOpenPrompt();
+    void editorTrimCaches();
+    int editorDirtyBuffers();
     void editorDrawRows(std::string &ab);
     int getWindowSize(int *rows, int *cols);
     int getCursorPosition(int *rows, int *cols);
-    void editorInsertRow(int at, char *s, size_t len);
     void editorScroll();
-    void editorUpdateRow(trow_ *row);
-    int editorRowCxToRx(trow_ *row, int cx);
     void editorDrawStatusBar(std::string &ab);
     void editorDrawMessageBar(std::string &ab);
-    void editorRowInsertChar(trow_ *row, int at, int c);
-    void editorInsertChar(int c);
-    char *editorRowToString(int *buflen);
     void editorSave();
-    void editorRowDeleteChar(trow_ *row, int at);
-    void editorDelChar();
-    void editorFreeRow(trow_ *row);
-    void editorDelRow(int at);
-    void editorRowAppendString(trow_ *row, char *s, size_t len);
-    void editorInsertNewLine();
     char *editorPrompt(char *prompt, std::function<void(char*, int)> callback);
     void editorFind();
-    int editorRowRxToCx(trow_ *row, int rx);
     void editorFindCallback(char *query, int key);
-    void editorUpdateSyntax(trow_ *row);
-    int editorSyntaxToColor(int hl);
-    int is_separator(int c);
-    void editorSelectSyntaxHighlight();
+    void editorGoto();
 };
 
 #endif // TERM_HPP
\ No newline at end of file
@@ -0,0 +1,25 @@
+// utf8.hpp
+#pragma once
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* True when no byte has the high bit set; checked 16 bytes at a time. */
+bool utf8IsAscii(const char *s, size_t len);
+
+/* Decodes the sequence at s into *cp and returns its length in bytes.
+ * Malformed or truncated input decodes one byte as UTF8_INVALID. */
+#define UTF8_INVALID 0xFFFFFFFFu
+int utf8Decode(const char *s, size_t len, uint32_t *cp);
+
+/* Terminal columns of a codepoint: 0 for combining marks, 2 for wide East
+ * Asian and emoji ranges, -1 for controls and invalid bytes. */
+int utf8Width(uint32_t cp);
+
+static inline bool utf8IsCont(char c) {
+    return ((unsigned char)c & 0xC0) == 0x80;
+}
+
+#endif // UTF8_HPP
@@ -0,0 +1,119 @@
+/*** includes ***/
+#include "include/intern.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+/*** helpers ***/
+/* Eight bytes per step instead of one; the tail is read as a partial word. */
+uint64_t lineHash(const char *s, size_t len) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ len;
+    size_t j = 0;
+    for (; j + 8 <= len; j += 8) {
+        uint64_t w;
+        memcpy(&w, s + j, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+    uint64_t w = 0;
+    memcpy(&w, s + j, len - j);
+    h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 29);
+}
+
+/*** table ***/
+LineTable::LineTable() : lookups(0), hits(0), buckets(1024, NULL), count(0) {}
+
+LineTable::~LineTable() {
+    for (LineAtom *a : buckets) {
+        while (a) {
+            LineAtom *next = a->next;
+            free(a->render);
+            free(a->hl.load());
+            a->~LineAtom();
+            free(a);
+            a = next;
+        }
+    }
+}
+
+LineAtom *LineTable::intern(const char *s, size_t len) {
+    uint64_t h = lineHash(s, len);
+    size_t b = h & (buckets.size() - 1);
+    lookups++;
+
+    for (LineAtom *a = buckets[b]; a; a = a->next) {
+        if (a->hash == h && (size_t)a->size == len && !memcmp(a->chars, s, len)) {
+            a->refs++;
+            hits++;
+            return a;
+        }
+    }
+
+    LineAtom *a = (LineAtom *)malloc(offsetof(LineAtom, chars) + len + 1);
+    new (a) LineAtom();
+    a->hash = h;
+    a->refs = 1;
+    a->size = len;
+    a->r_size = 0;
+    a->width = 0;
+    a->ascii = true;
+    a->render = NULL;
+    a->hl = NULL;
+    memcpy(a->chars, s, len);
+    a->chars[len] = '\0';
+
+    a->next = buckets[b];
+    buckets[b] = a;
+    if (++count > buckets.size()) grow();
+    return a;
+}
+
+void LineTable::release(LineAtom *atom) {
+    if (--atom->refs > 0) return;
+
+    LineAtom **p = &buckets[atom->hash & (buckets.size() - 1)];
+    while (*p != atom) p = &(*p)->next;
+    *p = atom->next;
+    count--;
+
+    free(atom->render);
+    free(atom->hl.load());
+    atom->~LineAtom();
+    free(atom);
+}
+
+/* Atoms with their shared render and hl, plus the bucket array. */
+size_t LineTable::bytes() const {
+    size_t total = buckets.capacity() * sizeof(LineAtom *);
+    for (LineAtom *a : buckets) {
+        for (; a; a = a->next) {
+            total += offsetof(LineAtom, chars) + a->size + 1;
+            if (a->render) total += a->r_size + 1;
+            if (a->hl.load(std::memory_order_relaxed)) total += a->r_size + 1;
+        }
+    }
+    return total;
+}
+
+/* Shared highlights depend on the syntax; drop them when it changes. */
+void LineTable::clearHighlight() {
+    for (LineAtom *a : buckets) {
+        for (; a; a = a->next) free(a->hl.exchange(NULL));
+    }
+}
+
+void LineTable::grow() {
+    std::vector<LineAtom *> next(buckets.size() * 2, NULL);
+    for (LineAtom *a : buckets) {
+        while (a) {
+            LineAtom *after = a->next;
+            size_t b = a->hash & (next.size() - 1);
+            a->next = next[b];
+            next[b] = a;
+            a = after;
+        }
+    }
+    buckets.swap(next);
+}
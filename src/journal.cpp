@@ -0,0 +1,223 @@
+/*** includes ***/
+#include "include/journal.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+/*** checksum ***/
+struct Crc32Table {
+    uint32_t entry[256];
+
+    Crc32Table() {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+            entry[n] = c;
+        }
+    }
+};
+
+/* CRC-32 as zlib computes it, a table lookup per byte. */
+static uint32_t crc32Update(uint32_t crc, const void *data, size_t len) {
+    static const Crc32Table table;
+    const unsigned char *p = (const unsigned char *)data;
+    crc = ~crc;
+    while (len--) crc = table.entry[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t recordCrc(JournalRecord rec, const char *payload) {
+    rec.crc = 0;
+    uint32_t crc = crc32Update(0, &rec, sizeof(rec));
+    return crc32Update(crc, payload, rec.len);
+}
+
+/*** journal ***/
+Journal::Journal() : fd(-1), last_sync(0), unsynced(false) {}
+
+Journal::~Journal() {
+    if (fd == -1) return;
+    flush();
+    close(fd);
+}
+
+int Journal::open(const std::string &dir, const char *filename, const FileStamp &stamp,
+                  std::function<void(const JournalRecord &, const char *)> replay) {
+    char buf[PATH_MAX];
+    if (!realpath(filename, buf)) return -1;
+    real = buf;
+
+    mkdir(dir.c_str(), 0700);
+    path = sidecarPath(dir, filename, "journal");
+
+    /* One editor per journal: another one holding it is left alone, and
+     * this buffer goes without. The lock is re-taken if the file was
+     * discarded and replaced while waiting for it. */
+    int lockfd = -1;
+    for (;;) {
+        lockfd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (lockfd == -1) return -1;
+        if (flock(lockfd, LOCK_EX | LOCK_NB) == -1) {
+            int err = errno == EWOULDBLOCK ? EBUSY : errno;
+            close(lockfd);
+            errno = err;
+            return -1;
+        }
+        struct stat held, named;
+        if (fstat(lockfd, &held) == 0 && stat(path.c_str(), &named) == 0 &&
+            held.st_dev == named.st_dev && held.st_ino == named.st_ino) break;
+        close(lockfd);
+    }
+
+    /* Replay whatever a previous session left behind for the same base file. */
+    int replayed = 0;
+    off_t valid_end = 0;
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f) {
+        JournalHeader hdr;
+        if (fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+            memcmp(hdr.magic, JOURNAL_MAGIC, 4) == 0 &&
+            hdr.version == JOURNAL_VERSION &&
+            fileStampEqual(hdr.stamp, stamp) &&
+            hdr.path_len == real.size()) {
+            std::string p(hdr.path_len, '\0');
+            if (fread(&p[0], 1, hdr.path_len, f) == hdr.path_len && p == real) {
+                valid_end = sizeof(hdr) + hdr.path_len;
+
+                JournalRecord rec;
+                std::string payload;
+                while (fread(&rec, sizeof(rec), 1, f) == 1) {
+                    if (rec.len > (1U << 30)) break;
+                    payload.resize(rec.len);
+                    if (rec.len && fread(&payload[0], 1, rec.len, f) != rec.len) break;
+                    /* A damaged record ends the replay like a torn one. */
+                    if (recordCrc(rec, payload.data()) != rec.crc) break;
+                    replay(rec, payload.data());
+                    valid_end += sizeof(rec) + rec.len;
+                    replayed++;
+                }
+            }
+        }
+        fclose(f);
+    }
+
+    /* Drop a torn or damaged record and everything after it, and keep
+     * appending from there; with nothing valid, start over. */
+    fd = lockfd;
+    if (ftruncate(fd, valid_end) == -1 || lseek(fd, valid_end, SEEK_SET) == -1 ||
+        (valid_end == 0 && writeHeader(stamp) == -1)) {
+        if (fd != -1) close(fd);
+        fd = -1;
+        return -1;
+    }
+
+    last_sync = time(NULL);
+    unsynced = false;
+    return replayed;
+}
+
+int Journal::writeHeader(const FileStamp &stamp) {
+    JournalHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, JOURNAL_MAGIC, 4);
+    hdr.version = JOURNAL_VERSION;
+    hdr.stamp = stamp;
+    hdr.path_len = real.size();
+
+    pending.append((const char *)&hdr, sizeof(hdr));
+    pending.append(real);
+    flush();
+    return fd == -1 ? -1 : 0;
+}
+
+void Journal::record(int op, int row, int at, const char *s, uint32_t len) {
+    if (fd == -1) return;
+
+    JournalRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.op = op;
+    rec.row = row;
+    rec.at = at;
+    rec.len = len;
+    rec.crc = recordCrc(rec, s);
+    pending.append((const char *)&rec, sizeof(rec));
+    if (len) pending.append(s, len);
+
+    if (pending.size() >= JOURNAL_FLUSH_BYTES) flush();
+}
+
+void Journal::flush() {
+    size_t done = 0;
+    while (done < pending.size()) {
+        ssize_t n = write(fd, pending.data() + done, pending.size() - done);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            /* Stop journaling rather than leave a hole in the record stream. */
+            close(fd);
+            fd = -1;
+            break;
+        }
+        done += n;
+    }
+    if (done) unsynced = true;
+    pending.clear();
+}
+
+void Journal::commit() {
+    if (fd == -1) return;
+    if (!pending.empty()) flush();
+    if (fd == -1 || !unsynced) return;
+
+    time_t now = time(NULL);
+    if (now - last_sync < JOURNAL_SYNC_SECONDS) return;
+
+    #ifdef __APPLE__
+    fsync(fd);
+    #else
+    fdatasync(fd);
+    #endif
+    last_sync = now;
+    unsynced = false;
+}
+
+/* Hands out a duplicate of the journal fd so the caller can fdatasync it
+ * off the input path; the records written so far count as synced. */
+int Journal::detachSync() {
+    if (fd == -1) return -1;
+    if (!pending.empty()) flush();
+    if (fd == -1) return -1;
+
+    int dupfd = dup(fd);
+    if (dupfd == -1) return -1;
+    last_sync = time(NULL);
+    unsynced = false;
+    return dupfd;
+}
+
+void Journal::reset(const FileStamp &stamp) {
+    if (fd == -1) return;
+    pending.clear();
+    if (ftruncate(fd, 0) == -1 || lseek(fd, 0, SEEK_SET) == -1) {
+        close(fd);
+        fd = -1;
+        return;
+    }
+    writeHeader(stamp);
+}
+
+/* Unlinked while still locked, so no other editor can take the file in
+ * between and lose it. */
+void Journal::discard() {
+    if (fd == -1) return;
+    unlink(path.c_str());
+    close(fd);
+    fd = -1;
+    pending.clear();
+}
@@ -0,0 +1,114 @@
+/*** includes ***/
+#include "include/lz.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+/*** helpers ***/
+static uint32_t read32(const char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hash4(uint32_t v) {
+    return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static void putLength(std::string &out, size_t n) {
+    while (n >= 255) {
+        out += (char)255;
+        n -= 255;
+    }
+    out += (char)n;
+}
+
+static void emit(std::string &out, const char *lit, size_t lit_len, size_t offset, size_t match_len) {
+    size_t ml = match_len ? match_len - LZ_MIN_MATCH : 0;
+    unsigned char token = (unsigned char)((lit_len < 15 ? lit_len : 15) << 4 | (ml < 15 ? ml : 15));
+    out += (char)token;
+    if (lit_len >= 15) putLength(out, lit_len - 15);
+    out.append(lit, lit_len);
+    if (!match_len) return;
+
+    out += (char)(offset & 0xff);
+    out += (char)(offset >> 8);
+    if (ml >= 15) putLength(out, ml - 15);
+}
+
+/*** codec ***/
+void lzCompress(const char *src, size_t len, std::string &out) {
+    out.clear();
+    out.reserve(len / 2 + 16);
+
+    uint32_t table[1 << LZ_HASH_BITS];
+    memset(table, 0xff, sizeof(table));
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (len >= LZ_MIN_MATCH && i + LZ_MIN_MATCH <= len) {
+        uint32_t v = read32(src + i);
+        uint32_t h = hash4(v);
+        uint32_t cand = table[h];
+        table[h] = i;
+
+        if (cand == UINT32_MAX || i - cand > 0xffff || read32(src + cand) != v) {
+            i++;
+            continue;
+        }
+
+        size_t m = LZ_MIN_MATCH;
+        while (i + m < len && src[cand + m] == src[i + m]) m++;
+
+        emit(out, src + anchor, i - anchor, i - cand, m);
+        i += m;
+        anchor = i;
+    }
+    emit(out, src + anchor, len - anchor, 0, 0);
+}
+
+int lzDecompress(const char *src, size_t len, char *dst, size_t dst_len) {
+    const unsigned char *ip = (const unsigned char *)src;
+    const unsigned char *end = ip + len;
+    size_t op = 0;
+
+    while (ip < end) {
+        unsigned token = *ip++;
+
+        size_t lit = token >> 4;
+        if (lit == 15) {
+            unsigned char b;
+            do {
+                if (ip >= end) return -1;
+                b = *ip++;
+                lit += b;
+            } while (b == 255);
+        }
+        if (lit > (size_t)(end - ip) || lit > dst_len - op) return -1;
+        memcpy(dst + op, ip, lit);
+        ip += lit;
+        op += lit;
+        if (ip == end) break;
+
+        if (end - ip < 2) return -1;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t m = (token & 15);
+        if (m == 15) {
+            unsigned char b;
+            do {
+                if (ip >= end) return -1;
+                b = *ip++;
+                m += b;
+            } while (b == 255);
+        }
+        m += LZ_MIN_MATCH;
+        if (offset == 0 || offset > op || m > dst_len - op) return -1;
+
+        /* Byte by byte: matches may overlap their own output. */
+        const char *from = dst + op - offset;
+        for (size_t k = 0; k < m; k++) dst[op + k] = from[k];
+        op += m;
+    }
+    return op == dst_len ? 0 : -1;
+}
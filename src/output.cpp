@@ -0,0 +1,126 @@
+/*** includes ***/
+#include "include/output.hpp"
+#include "include/perf.hpp"
+#include "include/utf8.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+/*** output ***/
+TermOutput::TermOutput()
+    : stats(), out(-1), own(false), stalled(false), sent(0), busy_since(0) {}
+
+TermOutput::~TermOutput() {
+    if (own) close(out);
+}
+
+/* Without a tty name (output redirected) writes go to out_fd as it is,
+ * blocking. */
+int TermOutput::open(int out_fd) {
+    const char *name = ttyname(out_fd);
+    int fd = name ? ::open(name, O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC) : -1;
+    own = fd != -1;
+    out = own ? fd : out_fd;
+    return own ? 0 : -1;
+}
+
+/* Writes until the terminal refuses more; a failed terminal counts as
+ * having taken everything, there is no one left to wait for. */
+size_t TermOutput::writeSome(const char *s, size_t len) {
+    size_t done = 0;
+    stalled = false;
+    while (done < len) {
+        ssize_t n = write(out, s + done, len - done);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            stalled = true;
+            stats.stalls++;
+            return done;
+        }
+        if (n <= 0) return len;
+        done += n;
+        stats.bytes += n;
+    }
+    return done;
+}
+
+void TermOutput::idle() {
+    buf.clear();
+    sent = 0;
+    stats.busy_ns += perfNow() - busy_since;
+    busy_since = 0;
+}
+
+void TermOutput::frame(const std::string &ab) {
+    stats.frames++;
+    if (!busy_since) busy_since = perfNow();
+
+    if (pending()) {
+        /* Keep only what finishes the sequence or character the terminal
+         * is in the middle of; the new frame redraws the rest. */
+        size_t cut = safeCut();
+        if (cut < buf.size()) stats.merged++;
+        buf.resize(cut);
+        buf.erase(0, sent);
+        sent = 0;
+        buf.append("\x1b[m", 3);
+        buf.append(ab);
+        flush();
+        return;
+    }
+
+    /* Common case: the whole frame goes out without being copied. */
+    size_t n = writeSome(ab.data(), ab.size());
+    if (n == ab.size()) {
+        idle();
+        return;
+    }
+    buf.assign(ab, n, std::string::npos);
+    sent = 0;
+}
+
+bool TermOutput::flush() {
+    if (!pending()) return true;
+    sent += writeSome(buf.data() + sent, buf.size() - sent);
+    if (pending()) return false;
+    idle();
+    return true;
+}
+
+/* The first offset at or after sent that is not inside an escape sequence
+ * or a UTF-8 character. Sequences in a frame are short, so looking back a
+ * few bytes for ESC is enough. */
+size_t TermOutput::safeCut() const {
+    size_t cut = sent;
+    size_t back = sent > 32 ? sent - 32 : 0;
+    for (size_t k = sent; k > back; k--) {
+        if (buf[k - 1] != '\x1b') continue;
+        size_t end = k;
+        if (end < buf.size() && buf[end] == '[') {
+            end++;
+            while (end < buf.size() && (buf[end] < 0x40 || buf[end] > 0x7e)) end++;
+        }
+        end++;
+        if (end > cut) cut = end < buf.size() ? end : buf.size();
+        break;
+    }
+    while (cut < buf.size() && utf8IsCont(buf[cut])) cut++;
+    return cut;
+}
+
+void TermOutput::finish() {
+    if (out == -1 || !pending()) return;
+    buf.resize(safeCut());
+    buf.append("\x1b[m" OUTPUT_SYNC_END);
+    while (!flush()) {
+        struct pollfd pfd = { out, POLLOUT, 0 };
+        if (poll(&pfd, 1, OUTPUT_FINISH_MS) <= 0) break;
+    }
+}
+
+double TermOutput::throughput() const {
+    return stats.busy_ns ? stats.bytes * 1e9 / stats.busy_ns : 0.0;
+}
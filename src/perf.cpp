@@ -0,0 +1,143 @@
+/*** includes ***/
+#include "include/perf.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+
+/*** allocation counting ***/
+/* The counter is fed by the hooks in perfalloc.cpp; programs built without
+ * them keep the process allocator and count nothing. */
+static std::atomic<uint64_t> alloc_count(0);
+static std::atomic<bool> count_allocs(false);
+static bool allocs_hooked = false;
+
+void perfNoteAlloc() {
+    if (count_allocs.load(std::memory_order_relaxed)) alloc_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool perfAllocsHooked(bool hooked) {
+    if (hooked) allocs_hooked = true;
+    return allocs_hooked;
+}
+
+uint64_t perfAllocCount() {
+    return alloc_count.load(std::memory_order_relaxed);
+}
+
+void perfCountAllocs(bool on) {
+    count_allocs.store(on, std::memory_order_relaxed);
+}
+
+/* Resident set size in bytes, or 0 where it cannot be read cheaply. */
+uint64_t perfRss() {
+    #ifdef __linux__
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long long size, resident;
+    int n = fscanf(f, "%llu %llu", &size, &resident);
+    fclose(f);
+    return n == 2 ? resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+    #else
+    return 0;
+    #endif
+}
+
+uint64_t perfNow() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*** perf ***/
+Perf perf;
+
+static const char *phase_names[PERF_PHASES] = {
+    "key", "dispatch", "scroll", "highlight", "draw", "write"
+};
+
+Perf::Perf()
+    : enabled(false), samples(), bytes(), allocs(), counts(), events(NULL),
+      nevents(0), next_event(0), origin_ns(0) {}
+
+void Perf::enable(bool on) {
+    if (on && !events) {
+        events = (PerfEvent *)calloc(PERF_EVENTS, sizeof(PerfEvent));
+        if (!events) return;
+        origin_ns = perfNow();
+    }
+    enabled = on;
+    perfCountAllocs(on);
+}
+
+void Perf::end(int phase, uint64_t start_ns, uint64_t start_allocs, uint64_t nbytes) {
+    uint64_t dur = perfNow() - start_ns;
+    uint64_t nallocs = perfAllocCount() - start_allocs;
+
+    samples[phase][counts[phase] % PERF_WINDOW] = dur;
+    counts[phase]++;
+    bytes[phase] += nbytes;
+    allocs[phase] += nallocs;
+
+    PerfEvent *ev = &events[next_event];
+    ev->start_ns = start_ns;
+    ev->dur_ns = dur;
+    ev->allocs = nallocs;
+    ev->bytes = nbytes;
+    ev->phase = phase;
+    next_event = (next_event + 1) % PERF_EVENTS;
+    if (nevents < PERF_EVENTS) nevents++;
+}
+
+/* "key 3/9 dispatch 40/210 ..." -- p50/p99 in microseconds over the last
+ * PERF_WINDOW samples of every phase. */
+void Perf::overlay(char *buf, size_t len) {
+    size_t used = 0;
+    buf[0] = '\0';
+    for (int p = 0; p < PERF_PHASES && used < len; p++) {
+        int n = std::min(counts[p], PERF_WINDOW);
+        if (n == 0) continue;
+
+        uint64_t window[PERF_WINDOW];
+        memcpy(window, samples[p], n * sizeof(uint64_t));
+        std::sort(window, window + n);
+        uint64_t p50 = window[n / 2];
+        uint64_t p99 = window[(n * 99) / 100];
+
+        int w = snprintf(buf + used, len - used, "%s%s %llu/%llu",
+            used ? " " : "", phase_names[p],
+            (unsigned long long)(p50 / 1000), (unsigned long long)(p99 / 1000));
+        if (w < 0) break;
+        used += w;
+    }
+    if (used < len && counts[PERF_WRITE]) {
+        int w = snprintf(buf + used, len - used, " us | %llu B/frame",
+            (unsigned long long)(bytes[PERF_WRITE] / counts[PERF_WRITE]));
+        if (w > 0 && (used += w) < len && perfAllocsHooked()) {
+            snprintf(buf + used, len - used, " %llu allocs/frame",
+                (unsigned long long)(allocs[PERF_DRAW] / std::max(counts[PERF_DRAW], 1)));
+        }
+    }
+}
+
+int Perf::dumpTrace(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    size_t first = (next_event + PERF_EVENTS - nevents) % PERF_EVENTS;
+    for (size_t j = 0; j < nevents; j++) {
+        const PerfEvent *ev = &events[(first + j) % PERF_EVENTS];
+        fprintf(f, "{\"name\":\"%s\",\"cat\":\"edi\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+            "\"pid\":%d,\"tid\":1,\"args\":{\"allocs\":%llu,\"bytes\":%llu}}%s\n",
+            phase_names[ev->phase], (ev->start_ns - origin_ns) / 1000.0, ev->dur_ns / 1000.0,
+            (int)getpid(), (unsigned long long)ev->allocs, (unsigned long long)ev->bytes,
+            j + 1 < nevents ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    return fclose(f) == 0 ? (int)nevents : -1;
+}
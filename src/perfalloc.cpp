@@ -0,0 +1,70 @@
+/*** includes ***/
+#include "include/perf.hpp"
+
+#include <errno.h>
+#include <stdlib.h>
+
+/*** allocation hooks ***/
+/* Linked only into the programs built with EDI_COUNT_ALLOCS: every entry
+ * point of the process allocator is replaced by a forwarder to glibc that
+ * counts the call, so it must not end up in anything else, sanitizer
+ * builds least of all. */
+#if defined(__GLIBC__)
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t nmemb, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void __libc_free(void *ptr);
+extern "C" void *__libc_memalign(size_t alignment, size_t size);
+extern "C" void *__libc_valloc(size_t size);
+extern "C" void *__libc_pvalloc(size_t size);
+
+extern "C" void *malloc(size_t size) {
+    perfNoteAlloc();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t nmemb, size_t size) {
+    perfNoteAlloc();
+    return __libc_calloc(nmemb, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+    perfNoteAlloc();
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void *ptr) {
+    __libc_free(ptr);
+}
+
+extern "C" void *memalign(size_t alignment, size_t size) {
+    perfNoteAlloc();
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+    perfNoteAlloc();
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t alignment, size_t size) {
+    if (alignment % sizeof(void *) || (alignment & (alignment - 1))) return EINVAL;
+    perfNoteAlloc();
+    void *p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+extern "C" void *valloc(size_t size) {
+    perfNoteAlloc();
+    return __libc_valloc(size);
+}
+
+extern "C" void *pvalloc(size_t size) {
+    perfNoteAlloc();
+    return __libc_pvalloc(size);
+}
+
+static const bool hooked = (perfAllocsHooked(true), true);
+#endif
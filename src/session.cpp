@@ -0,0 +1,183 @@
+/*** includes ***/
+#include "include/session.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*** helpers ***/
+int fileStamp(const char *path, FileStamp *st) {
+    struct stat sb;
+    if (stat(path, &sb) == -1) return -1;
+
+    st->size = sb.st_size;
+    #ifdef __APPLE__
+    st->mtime_sec = sb.st_mtimespec.tv_sec;
+    st->mtime_nsec = sb.st_mtimespec.tv_nsec;
+    #else
+    st->mtime_sec = sb.st_mtim.tv_sec;
+    st->mtime_nsec = sb.st_mtim.tv_nsec;
+    #endif
+    return 0;
+}
+
+bool fileStampEqual(const FileStamp &a, const FileStamp &b) {
+    return a.size == b.size && a.mtime_sec == b.mtime_sec && a.mtime_nsec == b.mtime_nsec;
+}
+
+uint64_t pathHash(const char *path) {
+    uint64_t h = 1469598103934665603ULL;
+    for (const unsigned char *p = (const unsigned char *)path; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string sidecarPath(const std::string &dir, const char *path, const char *ext) {
+    char real[PATH_MAX];
+    if (!realpath(path, real)) snprintf(real, sizeof(real), "%s", path);
+
+    char name[48];
+    snprintf(name, sizeof(name), "%016llx.%s", (unsigned long long)pathHash(real), ext);
+    return dir + "/" + name;
+}
+
+static size_t pad8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+/*** session ***/
+Session::Session()
+    : header(NULL), offsets(NULL), lengths(NULL), r_sizes(NULL),
+      open_comment(NULL), map(NULL), map_len(0) {}
+
+Session::~Session() {
+    close();
+}
+
+void Session::close() {
+    if (map) munmap(map, map_len);
+    map = NULL;
+    map_len = 0;
+    header = NULL;
+    offsets = NULL;
+    lengths = NULL;
+    r_sizes = NULL;
+    open_comment = NULL;
+}
+
+int Session::load(const std::string &dir, const char *filename, const char *filetype, int tab_stop) {
+    close();
+
+    FileStamp stamp;
+    if (fileStamp(filename, &stamp) == -1) return -1;
+
+    int fd = open(sidecarPath(dir, filename, "session").c_str(), O_RDONLY);
+    if (fd == -1) return -1;
+
+    struct stat sb;
+    if (fstat(fd, &sb) == -1 || (size_t)sb.st_size < sizeof(SessionHeader)) {
+        ::close(fd);
+        return -1;
+    }
+    map_len = sb.st_size;
+    map = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        map = NULL;
+        map_len = 0;
+        return -1;
+    }
+
+    header = (const SessionHeader *)map;
+    const char *p = (const char *)map + sizeof(SessionHeader);
+
+    char real[PATH_MAX];
+    if (!realpath(filename, real)) snprintf(real, sizeof(real), "%s", filename);
+
+    uint64_t n = header->numrows;
+    size_t need = sizeof(SessionHeader) + pad8(header->path_len) +
+                  n * (sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(uint8_t));
+
+    if (memcmp(header->magic, SESSION_MAGIC, 4) != 0 ||
+        header->version != SESSION_VERSION ||
+        !fileStampEqual(header->stamp, stamp) ||
+        header->tab_stop != tab_stop ||
+        strncmp(header->filetype, filetype ? filetype : "", sizeof(header->filetype)) != 0 ||
+        header->path_len != strlen(real) ||
+        n > (map_len / sizeof(uint64_t)) || need > map_len ||
+        memcmp(p, real, header->path_len) != 0) {
+        close();
+        return -1;
+    }
+
+    p += pad8(header->path_len);
+    offsets = (const uint64_t *)p;
+    p += n * sizeof(uint64_t);
+    lengths = (const uint32_t *)p;
+    p += n * sizeof(uint32_t);
+    r_sizes = (const uint32_t *)p;
+    p += n * sizeof(uint32_t);
+    open_comment = (const uint8_t *)p;
+
+    for (uint64_t j = 0; j < n; j++) {
+        if (offsets[j] + lengths[j] > stamp.size) {
+            close();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int Session::store(const std::string &dir, const char *filename, const char *filetype,
+                   const SessionState &state, const std::vector<uint64_t> &offsets,
+                   const std::vector<uint32_t> &lengths, const std::vector<uint32_t> &r_sizes,
+                   const std::vector<uint8_t> &open_comment) {
+    SessionHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    if (fileStamp(filename, &hdr.stamp) == -1) return -1;
+
+    char real[PATH_MAX];
+    if (!realpath(filename, real)) return -1;
+
+    memcpy(hdr.magic, SESSION_MAGIC, 4);
+    hdr.version = SESSION_VERSION;
+    hdr.numrows = offsets.size();
+    snprintf(hdr.filetype, sizeof(hdr.filetype), "%s", filetype ? filetype : "");
+    hdr.tab_stop = state.tab_stop;
+    hdr.cursor_x = state.cursor_x;
+    hdr.cursor_y = state.cursor_y;
+    hdr.row_offset = state.row_offset;
+    hdr.col_offset = state.col_offset;
+    hdr.path_len = strlen(real);
+
+    mkdir(dir.c_str(), 0755);
+    std::string path = sidecarPath(dir, filename, "session");
+    std::string tmp = path + ".tmp";
+
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if (!f) return -1;
+
+    static const char zeros[8] = {0};
+    size_t n = hdr.numrows;
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              fwrite(real, 1, hdr.path_len, f) == hdr.path_len &&
+              fwrite(zeros, 1, pad8(hdr.path_len) - hdr.path_len, f) == pad8(hdr.path_len) - hdr.path_len &&
+              fwrite(offsets.data(), sizeof(uint64_t), n, f) == n &&
+              fwrite(lengths.data(), sizeof(uint32_t), n, f) == n &&
+              fwrite(r_sizes.data(), sizeof(uint32_t), n, f) == n &&
+              fwrite(open_comment.data(), sizeof(uint8_t), n, f) == n;
+
+    if (fclose(f) != 0) ok = false;
+    if (!ok || rename(tmp.c_str(), path.c_str()) == -1) {
+        unlink(tmp.c_str());
+        return -1;
+    }
+    return 0;
+}
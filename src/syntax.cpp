@@ -0,0 +1,350 @@
+/*** includes ***/
+#include "include/buffer.hpp"
+#include "include/config.hpp"
+#include "include/perf.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*** filetypes ***/
+const char *C_HL_extensions[] = { ".c", ".h", ".cpp", ".hpp", nullptr };
+const char *C_HL_keywords[] = {
+    "switch", "if", "while", "for", "break", "continue", "return", "else",
+    "struct", "union", "typedef", "static", "enum", "class", "case",
+    "int|", "long|", "double|", "float|", "char|", "unsigned|", "signed|",
+    "void|", nullptr
+};
+
+editorSyntax HLDB[] = {
+    {
+        "c",
+        C_HL_extensions,
+        C_HL_keywords,
+        "//", "/*", "*/",
+        HL_HIGHLIGHT_NUMBERS | HL_HIGHLIGHT_STRINGS
+    }
+};
+
+#define HLDB_ENTRIES (sizeof(HLDB) / sizeof(HLDB[0]))
+
+/*** highlight pool ***/
+/* Threads for whole-buffer passes, started by the first one and kept for
+ * the life of the process: starting them per pass costs as much as lexing
+ * a mid-sized file. One pass runs at a time. */
+class HighlightPool {
+public:
+    ~HighlightPool() {
+        {
+            std::lock_guard<std::mutex> g(lock);
+            stopping = true;
+        }
+        start.notify_all();
+        for (auto &t : threads) t.join();
+    }
+
+    size_t size() const { return std::max(1u, std::thread::hardware_concurrency()); }
+
+    /* Runs job on every pool thread and on the caller, and returns once
+     * all of them have returned. */
+    void run(const std::function<void()> &job) {
+        std::lock_guard<std::mutex> one(busy);
+        std::unique_lock<std::mutex> g(lock);
+        while (threads.size() + 1 < size()) threads.emplace_back(&HighlightPool::loop, this, generation);
+        current = &job;
+        running = threads.size();
+        generation++;
+        g.unlock();
+        start.notify_all();
+
+        job();
+
+        g.lock();
+        finished.wait(g, [this] { return running == 0; });
+        current = NULL;
+    }
+
+private:
+    /* seen is the pass current when the thread was started; the one
+     * about to be announced is its first. */
+    void loop(uint64_t seen) {
+        std::unique_lock<std::mutex> g(lock);
+        for (;;) {
+            start.wait(g, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            const std::function<void()> *job = current;
+            g.unlock();
+            (*job)();
+            g.lock();
+            if (--running == 0) finished.notify_one();
+        }
+    }
+
+    std::mutex busy;
+    std::mutex lock;
+    std::condition_variable start;
+    std::condition_variable finished;
+    std::vector<std::thread> threads;
+    const std::function<void()> *current = NULL;
+    uint64_t generation = 0;
+    size_t running = 0;
+    bool stopping = false;
+};
+
+static HighlightPool hlPool;
+
+/*** syntax ***/
+int Buffer::editorHighlightRow(trow_ *row, int in_comment) {
+    LineAtom *atom = row->atom;
+    if (atom && !in_comment) {
+        unsigned char *shared = atom->hl.load(std::memory_order_acquire);
+        if (!shared) {
+            unsigned char *hl = (unsigned char *)malloc(row->r_size + 1);
+            hl[row->r_size] = editorLexRow(row, hl, 0);
+            if (atom->hl.compare_exchange_strong(shared, hl, std::memory_order_acq_rel)) shared = hl;
+            else free(hl);
+        }
+        if (row->hl != shared) free(row->hl);
+        row->hl = shared;
+        return shared[row->r_size];
+    }
+
+    if (atom && row->hl == atom->hl.load(std::memory_order_relaxed)) row->hl = NULL;
+    row->hl = (unsigned char *)realloc(row->hl, row->r_size);
+    return editorLexRow(row, row->hl, in_comment);
+}
+
+int Buffer::editorLexRow(const trow_ *row, unsigned char *hl, int in_comment) {
+    memset(hl, HL_NORMAL, row->r_size);
+
+    if (syntax == NULL) return 0;
+
+    const char **keywords = syntax->keywords;
+
+    const char *scs = syntax->single_line_comment_start;
+    const char *mcs = syntax->multiline_comment_start;
+    const char *mce = syntax->multiline_comment_end;
+
+    int scs_len = scs ? strlen(scs) : 0;
+    int mcs_len = mcs ? strlen(mcs) : 0;
+    int mce_len = mce ? strlen(mce) : 0;
+
+    bool prev_sep = 1;
+    bool in_string = 0;
+
+    int i = 0;
+    while (i < row->r_size) {
+        char c = row->render[i];
+        unsigned char prev_hl = (i > 0) ? hl[i - 1] : (unsigned char)HL_NORMAL;
+
+        if (scs_len && !in_string && !in_comment) {
+            if (!strncmp(&row->render[i], scs, scs_len)) {
+                memset(&hl[i], HL_COMMENT, row->r_size - i);
+                break;
+            }
+        }
+
+        if (mcs_len && mce_len && !in_string) {
+            if (in_comment) {
+                hl[i] = HL_MLCOMMENT;
+                if (!strncmp(&row->render[i], mce, mce_len)) {
+                    memset(&hl[i], HL_MLCOMMENT, mce_len);
+                    i += mce_len;
+                    in_comment = 0;
+                    prev_sep = 1;
+                    continue;
+                } else {
+                    i++;
+                    continue;
+                }
+            } else if (!strncmp(&row->render[i], mcs, mcs_len)) {
+                memset(&hl[i], HL_MLCOMMENT, mcs_len);
+                i += mcs_len;
+                in_comment = 1;
+                continue;
+            }
+        }
+
+        if (syntax->flags & HL_HIGHLIGHT_STRINGS) {
+            if (in_string) {
+                hl[i] = HL_STRING;
+                if (c == '\\' && i + 1 < row->r_size) {
+                    hl[i + 1] = HL_STRING;
+                    i += 2;
+                    continue;
+                }
+                if (c == in_string) in_string = 0;
+                i++;
+                prev_sep = 1;
+                continue;
+            } else if (c == '"' || c == '\'') {
+                in_string = c;
+                hl[i] = HL_STRING;
+                i++;
+                continue;
+            }
+        }
+
+        if(syntax->flags & HL_HIGHLIGHT_NUMBERS) {
+            if ((isdigit(c) && (prev_sep || prev_hl == HL_NUMBER)) ||
+                    (c == '.' && prev_hl == HL_NUMBER)){
+                hl[i] = HL_NUMBER;
+                i++;
+                prev_sep = 0;
+                continue;
+            }
+        }
+
+        if (prev_sep) {
+            int j;
+            for (j = 0; keywords[j]; j++) {
+                int klen = strlen(keywords[j]);
+                int kw2 = keywords[j][klen - 1] == '|';
+                if (kw2) klen--;
+
+                if (!strncmp(&row->render[i], keywords[j], klen) &&
+                        is_separator(row->render[i + klen])) {
+                    memset(&hl[i], kw2 ? HL_KEYWORD2 : HL_KEYWORD1, klen);
+                    i += klen;
+                    break;
+                }
+            }
+            if (keywords[j] != NULL) {
+                prev_sep = 0;
+                continue;
+            }
+        }
+
+        prev_sep = is_separator(c);
+        i++;
+    }
+
+    return in_comment;
+}
+
+void Buffer::editorUpdateSyntax(trow_ *row) {
+    editorUpdateSyntaxRange(row->idx, row->idx);
+}
+
+/* Lexes rows from .. to once each, then goes on past to only while the
+ * comment state carried into the next row keeps changing. */
+void Buffer::editorUpdateSyntaxRange(int from, int to) {
+    PERF_SCOPE(PERF_HIGHLIGHT);
+    int in_comment = from > 0 && rows[from - 1].hl_open_comment;
+    for (int j = from; j < numrows; j++) {
+        trow_ *row = &rows[j];
+        if (!row->render) editorUpdateRender(row);
+        in_comment = editorHighlightRow(row, in_comment);
+
+        int changed = (row->hl_open_comment != in_comment);
+        row->hl_open_comment = in_comment;
+        if (!changed && j >= to) break;
+    }
+}
+
+void Buffer::editorUpdateSyntaxAll() {
+    PERF_SCOPE(PERF_HIGHLIGHT);
+    size_t nthreads = hlPool.size();
+
+    /* Cold rows are read through the store's one decompressed block, which
+     * is not shared between threads. */
+    if (nthreads < 2 || numrows < HL_PARALLEL_MIN_ROWS || cold.stats.rows) {
+        int in_comment = 0;
+        for (int j = 0; j < numrows; j++) {
+            in_comment = editorRowLexState(&rows[j], in_comment);
+            rows[j].hl_open_comment = in_comment;
+        }
+        return;
+    }
+
+    /* Every chunk is lexed as if it started outside of a comment. */
+    int nchunks = nthreads * 4;
+    int chunk = (numrows + nchunks - 1) / nchunks;
+    nchunks = (numrows + chunk - 1) / chunk;
+
+    std::atomic<int> next(0);
+    hlPool.run([&]() {
+        int k;
+        while ((k = next++) < nchunks) {
+            int end = std::min((k + 1) * chunk, numrows);
+            int in_comment = 0;
+            for (int j = k * chunk; j < end; j++) {
+                in_comment = editorRowLexState(&rows[j], in_comment);
+                rows[j].hl_open_comment = in_comment;
+            }
+        }
+    });
+
+    /* Fix-up: re-lex the chunks whose real entry state differs from the
+     * assumed one, until the lexer state converges with the first pass. */
+    for (int k = 1; k < nchunks; k++) {
+        int start = k * chunk;
+        int in_comment = rows[start - 1].hl_open_comment;
+        if (!in_comment) continue;
+
+        int end = std::min(start + chunk, numrows);
+        for (int j = start; j < end; j++) {
+            int prev = rows[j].hl_open_comment;
+            in_comment = editorRowLexState(&rows[j], in_comment);
+            rows[j].hl_open_comment = in_comment;
+            if (in_comment == prev) break;
+        }
+    }
+}
+
+int Buffer::editorSyntaxToColor(int hl) {
+    switch (hl) {
+        case HL_MLCOMMENT:
+        case HL_COMMENT: return cfg.config.hl_comment;
+        case HL_KEYWORD1: return cfg.config.hl_keyword1;
+        case HL_KEYWORD2: return cfg.config.hl_keyword2;
+        case HL_NUMBER: return cfg.config.hl_number;
+        case HL_MATCH: return cfg.config.hl_match;
+        case HL_STRING: return cfg.config.hl_string;
+        default: return 37;
+    }
+}
+
+int Buffer::is_separator(int c) {
+    return isspace(c) || c == '\0' || strchr(",.()+-/*=~%<>[];", c) != NULL;
+}
+
+void Buffer::editorSelectSyntaxHighlight() {
+    syntax = highlight ? editorFindSyntax() : NULL;
+    if (!highlight) return;
+    if (lines.atoms()) {
+        for (int j = 0; j < numrows; j++) {
+            if (rows[j].atom && rows[j].hl == rows[j].atom->hl.load()) rows[j].hl = NULL;
+        }
+        lines.clearHighlight();
+    }
+    if (syntax || lines.atoms()) editorUpdateSyntaxAll();
+}
+
+struct editorSyntax *Buffer::editorFindSyntax() {
+    if (filename == NULL) return NULL;
+
+    char *ext = strrchr(filename, '.');
+
+    for (unsigned int j = 0; j < HLDB_ENTRIES; j++) {
+        struct editorSyntax *s = &HLDB[j];
+        unsigned int i = 0;
+        while(s->filematch[i]) {
+            int is_ext = (s->filematch[i][0] == '.');
+            if ((is_ext && ext && !strcmp(ext, s->filematch[i])) ||
+                (!is_ext && strstr(filename, s->filematch[i]))) {
+                return s;
+            }
+            i++;
+        }
+    }
+    return NULL;
+}
@@ -2,33 +2,28 @@
 #define _DEFAULT_SOURCE
 #define _BSD_SOURCE
 
-#define HL_HIGHLIGHT_NUMBERS (1<<0)
-#define HL_HIGHLIGHT_STRINGS (1<<1)
 #define CTRL_KEY(key) ((key) & 0x1f)
 
 /*** includes ***/
 #include "include/term.hpp"
 #include "include/config.hpp"
+#include "include/perf.hpp"
 #include "version.hpp"
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 /*** usings ***/
 using namespace std;
 
 /*** init ***/
-Config cfg;
-
-Term::Term() : _C {} {
-    const char* home = std::getenv("HOME");
-    if (!home) die("Не удалось получить HOME");
+Term::Term() : _C {}, current(0), use_clock(0), _B(NULL), redraw_owed(false), reclaim_pending(false), diff_loading(false) {
+    std::string dir = Config::defaultDir();
+    if (dir.empty()) die("Не удалось получить HOME");
 
     namespace fs = std::filesystem;
-    fs::path configDir;
-
-    #ifdef __APPLE__
-    configDir = fs::path(home) / "Library" / "Application Support" / "edi";
-    #else
-    configDir = fs::path(home) / ".config" / "edi";
-    #endif
+    configDir = fs::path(dir);
 
     std::error_code ec;
     if (!fs::exists(configDir) && !fs::create_directories(configDir, ec)) {
@@ -48,46 +43,26 @@ Term::Term() : _C {} {
     }
 
     if (cfg.loadConfig(configPath.string()) == 1) die("loadConfig");
+    editorSwitchBuffer(editorAddBuffer(NULL));
 
+    if (loop.open(STDIN_FILENO) == -1) die("event loop");
+    output.open(STDOUT_FILENO);
     enableRawMode();
 }
 
 Term::~Term() {
+    clip.clear();
+    for (BufferSlot &slot : buffers) {
+        if (!slot.loaded) continue;
+        slot.buffer->editorStoreSession();
+        slot.buffer->journal.discard();
+    }
     disableRawMode();
 }
 
-struct editorSyntax {
-    const char *filetype;
-    const char **filematch;
-    const char **keywords;
-    const char *single_line_comment_start;
-    const char *multiline_comment_start;
-    const char *multiline_comment_end;
-    int flags;
-};
-
-const char *C_HL_extensions[] = { ".c", ".h", ".cpp", ".hpp", nullptr };
-const char *C_HL_keywords[] = {
-    "switch", "if", "while", "for", "break", "continue", "return", "else",
-    "struct", "union", "typedef", "static", "enum", "class", "case",
-    "int|", "long|", "double|", "float|", "char|", "unsigned|", "signed|",
-    "void|", nullptr
-};
-
-editorSyntax HLDB[] = {
-    {
-        "c",
-        C_HL_extensions,
-        C_HL_keywords,
-        "//", "/*", "*/",
-        HL_HIGHLIGHT_NUMBERS | HL_HIGHLIGHT_STRINGS
-    }
-};
-
-#define HLDB_ENTRIES (sizeof(HLDB) / sizeof(HLDB[0]))
-
 /*** methods ***/
 void Term::disableRawMode() {
+    output.finish();
     if(tcsetattr(STDIN_FILENO, TCSAFLUSH, &_C.orig_term) == -1) {
         die("tcsetattr in disableRawMode");
     }
@@ -115,6 +90,7 @@ void Term::enableRawMode() {
 }
 
 void Term::die(const char *msg) {
+    output.finish();
     write(STDOUT_FILENO, "\x1b[2J", 4);
     write(STDOUT_FILENO, "\x1b[H", 3);
 
@@ -125,9 +101,12 @@ void Term::die(const char *msg) {
 int Term::editorReadKey() {
     int nread;
     char c;
-    while ((nread = read(STDIN_FILENO, &c, 1)) != 1) {
-        if (nread == -1 && errno != EAGAIN) die("read");
+    while (true) {
+        editorWaitInput();
+        if ((nread = read(STDIN_FILENO, &c, 1)) == 1) break;
+        if (nread == -1 && errno != EAGAIN && errno != EINTR) die("read");
     }
+    PERF_SCOPE(PERF_READKEY);
 
     if (c == '\x1b') {
         char seq[8];
@@ -153,6 +132,14 @@ int Term::editorReadKey() {
                     case 'D':
                         return CTRL_ARROW_LEFT;
                     }
+                } else if (seq[2] == ';' && seq[3] == '3') {
+                    if (read(STDIN_FILENO, &seq[4], 1) != 1) return '\x1b';
+                    switch (seq[4]) {
+                    case 'A':
+                        return ALT_ARROW_UP;
+                    case 'B':
+                        return ALT_ARROW_DOWN;
+                    }
                 }
             } else if (seq[1] >= '0' && seq [1] <= '9') {
                 if (read(STDIN_FILENO, &seq[2], 1) != 1) return '\x1b';
@@ -168,6 +155,7 @@ int Term::editorReadKey() {
                     case 'B': return ARROW_DOWN;
                     case 'C': return ARROW_RIGHT;
                     case 'D': return ARROW_LEFT;
+                    case 'Z': return SHIFT_TAB;
                 }
             }
         }
@@ -178,10 +166,137 @@ int Term::editorReadKey() {
     }
 }
 
+/* Sleeps until a key arrives; resizes, expired timers and finished
+ * background jobs redraw the screen while waiting. */
+void Term::editorWaitInput() {
+    while (true) {
+        editorArmTimer();
+        int ev = loop.wait();
+        if (ev & EV_OUTPUT) editorFlushOutput(ev & EV_INPUT);
+        if (ev & EV_RESIZE) editorResize();
+        if (ev & EV_WAKE) loop.runCompletions();
+        if (ev & EV_TIMER) {
+            editorSyncJournal();
+            editorReclaim();
+        }
+        if (ev & EV_INPUT) return;
+        if (ev & ~EV_OUTPUT) editorRefreshScreen();
+    }
+}
+
+/* The terminal can take more. A frame skipped meanwhile is drawn now and
+ * replaces what is left of the stuck one, unless more keys are waiting:
+ * then the stuck one goes on and the keys decide what is drawn next. */
+void Term::editorFlushOutput(bool input) {
+    output.resume();
+    if (redraw_owed && !input) editorRefreshScreen();
+    else output.flush();
+    loop.watchOutput(output.fd(), output.pending());
+}
+
+void Term::editorArmTimer() {
+    int ms = 0;
+    if (_C.statusMsg[0]) {
+        long left = (long)(_C.statusMsg_time + STATUS_MSG_SECONDS - time(NULL));
+        if (left > 0) ms = left * 1000;
+    }
+    bool sync = false;
+    for (BufferSlot &slot : buffers) sync = sync || slot.buffer->journal.needsSync();
+    if (sync && (ms == 0 || ms > JOURNAL_SYNC_SECONDS * 1000)) {
+        ms = JOURNAL_SYNC_SECONDS * 1000;
+    }
+    if (reclaim_pending && (ms == 0 || ms > RECLAIM_IDLE_MS)) ms = RECLAIM_IDLE_MS;
+    loop.setTimer(ms);
+}
+
+void Term::editorResize() {
+    int rows, cols;
+    if (getWindowSize(&rows, &cols) == -1) return;
+    _C.screen_rows = rows - 2;
+    _C.screen_cols = cols;
+    if (_B->wrap_width) _B->editorSetWrap(editorTextCols());
+}
+
+void Term::editorSyncJournal() {
+    for (BufferSlot &slot : buffers) {
+        if (!slot.buffer->journal.needsSync()) continue;
+        int fd = slot.buffer->journal.detachSync();
+        if (fd == -1) continue;
+
+        auto err = std::make_shared<int>(0);
+        loop.submit([fd, err]() {
+            #ifdef __APPLE__
+            if (fsync(fd) == -1) *err = errno;
+            #else
+            if (fdatasync(fd) == -1) *err = errno;
+            #endif
+            close(fd);
+        }, [this, err]() {
+            if (*err) editorSetStatusMessage("Journal sync failed: %s", strerror(*err));
+        });
+    }
+}
+
+/* Over the RSS target, packs rows far from the screen and the cursor into
+ * compressed blocks and hands the freed heap back to the kernel. */
+void Term::editorReclaim() {
+    if (!reclaim_pending) return;
+    reclaim_pending = false;
+    editorTrimCaches();
+
+    uint64_t target = (uint64_t)cfg.config.rss_target_mb << 20;
+    if (!target || perfRss() <= target) return;
+
+    int margin = _C.screen_rows * 2;
+    int from = std::min(_B->row_offset, _B->cursor_y) - margin;
+    int to = std::max(_B->row_offset + _C.screen_rows, _B->cursor_y) + margin;
+    if (_B->editorFreeze(from, to) == 0) return;
+    #ifdef __GLIBC__
+    malloc_trim(0);
+    #endif
+}
+
+/* Where the current buffer's bytes go, next to the heap and RSS. */
+void Term::editorMemoryReport() {
+    MemStats st;
+    _B->editorMemStats(st);
+    auto mb = [](size_t bytes) { return bytes / 1048576.0; };
+
+    char heap[64] = "";
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 mi = mallinfo2();
+    snprintf(heap, sizeof(heap), " heap %.1fM free %.1fM", mb(mi.uordblks + mi.hblkhd), mb(mi.fordblks));
+    #endif
+    editorSetStatusMessage("text %.1fM+%.1fM render %.1fM hl %.1fM cols %.1fM rows %.1fM+%.1fM "
+        "shared %.1fM cold %.1fM index %.1fM |%s rss %.1fM",
+        mb(st.chars), mb(st.chars_slack), mb(st.render), mb(st.hl), mb(st.cols),
+        mb(st.rows), mb(st.rows_slack), mb(st.shared), mb(st.cold), mb(st.index),
+        heap, mb(perfRss()));
+}
+
+/* Brings a long session back to a small footprint: every loaded buffer
+ * keeps derived data for its screen only and repacks its text, then free
+ * pages go back to the OS; malloc_trim also madvises away free pages in
+ * the middle of the heap. */
+void Term::editorCompact() {
+    uint64_t before = perfRss();
+    for (BufferSlot &slot : buffers) {
+        if (!slot.loaded) continue;
+        Buffer *b = slot.buffer.get();
+        b->editorCompact(b->row_offset, b->row_offset + _C.screen_rows);
+        slot.derived = b->editorDerivedBytes();
+    }
+    #ifdef __GLIBC__
+    malloc_trim(0);
+    #endif
+    editorSetStatusMessage("Compacted: rss %.1fM -> %.1fM", before / 1048576.0, perfRss() / 1048576.0);
+}
+
 bool Term::editorProccessKeypress() {
     static int quit_times = cfg.config.quit_times;
 
     int c = editorReadKey();
+    PERF_SCOPE(PERF_DISPATCH);
 
     switch(c) {
         case CTRL_KEY('s'):
@@ -189,13 +304,15 @@ bool Term::editorProccessKeypress() {
             break;
 
         case '\r':
-            editorInsertNewLine();
+            _B->editorInsertNewLine();
             break;
 
         case CTRL_KEY('q'):
-            if (_C.dirty && quit_times > 0){
-                editorSetStatusMessage("Hey! This file is modified. "
+            if (editorDirtyBuffers() && quit_times > 0){
+                if (_B->dirty) editorSetStatusMessage("Hey! This file is modified. "
                     "Press CTRL-Q %d more times to quit", quit_times);
+                else editorSetStatusMessage("Hey! %d other buffers are modified. "
+                    "Press CTRL-Q %d more times to quit", editorDirtyBuffers(), quit_times);
                 quit_times--;
                 return true;
             } else return false;
@@ -204,10 +321,16 @@ bool Term::editorProccessKeypress() {
             // fall through
         case CTRL_ARROW_DOWN:
         {
-            if (c == CTRL_ARROW_UP) _C.cursor_y = _C.row_offset;
+            if (_B->wrap_width) {
+                int top = _B->editorVisualLine(_B->row_offset) + _C.wrap_sub;
+                if (c == CTRL_ARROW_UP) editorMoveVisual(top - _C.screen_rows);
+                else editorMoveVisual(top + 2 * _C.screen_rows - 1);
+                break;
+            }
+            if (c == CTRL_ARROW_UP) _B->cursor_y = _B->row_offset;
             else if (c == CTRL_ARROW_DOWN) {
-                _C.cursor_y = _C.row_offset + _C.screen_rows - 1;
-                if (_C.cursor_y > _C.numrows) _C.cursor_y = _C.numrows;
+                _B->cursor_y = _B->row_offset + _C.screen_rows - 1;
+                if (_B->cursor_y > _B->numrows) _B->cursor_y = _B->numrows;
             }
 
             int times = _C.screen_rows;
@@ -221,8 +344,57 @@ bool Term::editorProccessKeypress() {
             editorFind();
             break;
 
+        case CTRL_KEY('d'):
+            editorToggleDiff();
+            break;
+
+        case CTRL_KEY('g'):
+            editorGoto();
+            break;
+
+        case CTRL_KEY('o'):
+            editorOpenPrompt();
+            break;
+
+        case CTRL_KEY('n'):
+            editorSwitchBuffer((current + 1) % buffers.size());
+            break;
+
+        case CTRL_KEY('b'):
+            editorSwitchBuffer((current + buffers.size() - 1) % buffers.size());
+            break;
+
+        case CTRL_KEY('w'):
+            editorSetWrap(!_B->wrap_width);
+            editorSetStatusMessage(_B->wrap_width ? "Soft wrap on" : "Soft wrap off");
+            break;
+
+        case CTRL_KEY('p'):
+            perf.enable(!perf.enabled);
+            if (perf.enabled) _C.statusMsg[0] = '\0';
+            else editorSetStatusMessage("Performance overlay off");
+            break;
+
+        case CTRL_KEY('r'):
+            editorMemoryReport();
+            break;
+
+        case CTRL_KEY('k'):
+            editorCompact();
+            break;
+
+        case CTRL_KEY('t'):
+        {
+            char path[64];
+            snprintf(path, sizeof(path), "edi-trace-%d.json", (int)getpid());
+            int events = perf.dumpTrace(path);
+            if (events == -1) editorSetStatusMessage("Trace not written: %s", strerror(errno));
+            else editorSetStatusMessage("%d trace events written to %s", events, path);
+            break;
+        }
+
         case CTRL_ARROW_RIGHT:
-            if (_C.cursor_y < _C.numrows) _C.cursor_x = _C.row[_C.cursor_y].size;
+            if (_B->cursor_y < _B->numrows) _B->cursor_x = _B->rows[_B->cursor_y].size;
             break;
 
         case CTRL_ARROW_LEFT:
@@ -241,26 +413,65 @@ bool Term::editorProccessKeypress() {
         case BACKSPACE:
         case CTRL_KEY('h'):
             if (c == DEL_KEY) editorMoveCursor(ARROW_RIGHT);
-            editorDelChar();
+            _B->editorDelChar();
+            break;
+
+        case CTRL_KEY('a'):
+            if (_B->mark_y >= 0) {
+                _B->mark_y = -1;
+                editorSetStatusMessage("Mark cleared");
+            } else if (_B->cursor_y < _B->numrows) {
+                _B->mark_y = _B->cursor_y;
+                editorSetStatusMessage("Mark set");
+            }
+            break;
+
+        case '\t':
+            if (_B->mark_y >= 0) editorRangeCommand(c);
+            else _B->editorInsertChar(c);
+            break;
+
+        case CTRL_KEY('c'):
+        case CTRL_KEY('x'):
+        case CTRL_KEY('v'):
+        case CTRL_KEY('y'):
+        case ALT_ARROW_UP:
+        case ALT_ARROW_DOWN:
+        case SHIFT_TAB:
+            editorRangeCommand(c);
+            break;
 
         case CTRL_KEY('l'):
         case '\x1b':
             break;
 
         default:
-            editorInsertChar(c);
+            _B->editorInsertChar(c);
             break;
     }
 
     quit_times = cfg.config.quit_times;
+    _B->journal.commit();
+    if (cfg.config.rss_target_mb > 0 || cfg.config.cache_budget_mb > 0) reclaim_pending = true;
     return true;
 }
 
+/* Frames are built in abuf, which keeps its capacity, and go out as one
+ * synchronized update. While the terminal is not taking the previous one
+ * nothing is drawn; the newest state is drawn once it can. */
 void Term::editorRefreshScreen() {
+    if (output.blocked()) {
+        redraw_owed = true;
+        return;
+    }
+    redraw_owed = false;
+    _B->editorDiffUpdate();
     editorScroll();
 
-    string ab;
+    string &ab = abuf;
+    ab.clear();
 
+    ab += OUTPUT_SYNC_BEGIN;
     ab += "\x1b[?25l";
     ab += "\x1b[H";
     
@@ -269,19 +480,36 @@ void Term::editorRefreshScreen() {
     editorDrawMessageBar(ab);
 
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "\x1b[%d;%dH", (_C.cursor_y - _C.row_offset) + 1, (_C.r_x - _C.col_offset) + 1);
+    snprintf(buffer, sizeof(buffer), "\x1b[%d;%dH", _C.cursor_sy + 1, _C.cursor_sx + 1);
     ab += buffer;
 
     ab += "\x1b[?25h";
+    ab += OUTPUT_SYNC_END;
 
-    write(STDOUT_FILENO, ab.c_str(), ab.length());
+    PerfScope scope(PERF_WRITE);
+    scope.bytes = ab.length();
+    output.frame(ab);
+    loop.watchOutput(output.fd(), output.pending());
 }
 
 void Term::editorDrawRows(string &ab) {
+    PERF_SCOPE(PERF_DRAW);
+    int sel_from = 0, sel_to = -1;
+    if (_B->mark_y >= 0) editorSelection(&sel_from, &sel_to);
+    int fileRow = _B->row_offset;
+    int sub = _C.wrap_sub;
+    bool tail_marked = false;
     for (int y = 0; y < _C.screen_rows; y++) {
-        int fileRow = y + _C.row_offset;
-        if (fileRow >= _C.numrows) {
-            if (_C.numrows == 0 && y == _C.screen_rows / 2) {
+        if (!_B->wrap_width) fileRow = y + _B->row_offset;
+        if (_B->diff.active()) {
+            int at = -1;
+            if (fileRow < _B->numrows) at = sub == 0 ? fileRow : -1;
+            else if (!tail_marked) at = _B->numrows;
+            tail_marked = fileRow >= _B->numrows;
+            editorDrawGutter(ab, at);
+        }
+        if (fileRow >= _B->numrows) {
+            if (_B->numrows == 0 && y == _C.screen_rows / 2) {
                 char welcome_msg[80];
                 int welcomelen = snprintf(welcome_msg, sizeof(welcome_msg),
                 "%s -- version %s", 
@@ -300,56 +528,154 @@ void Term::editorDrawRows(string &ab) {
             } else {
             ab += '~';
             }
-        } else {
-            int len = _C.row[fileRow].r_size - _C.col_offset;
-            if (len < 0) len = 0;
-            if (len > _C.screen_cols) len = _C.screen_cols;
-            char *c = &_C.row[fileRow].render[_C.col_offset];
-            unsigned char *hl = &_C.row[fileRow].hl[_C.col_offset];
-            int current_color = -1;
-            for (int j = 0; j < len; j++) {
-                if (iscntrl(c[j])) {
-                    char sym = (c[j] <= 26) ? '@' + c[j] : '?';
-                    ab.append("\x1b[7m", 4);
-                    ab.append(&sym, 1);
-                    ab.append("\x1b[m", 3);
-                    if (current_color != -1) {
-                        char seq[16];
-                        int n = snprintf(seq, sizeof(seq), "\x1b[%dm", current_color);
-                        ab.append(seq, n);
-                    }
-                } else if (hl[j] == HL_NORMAL) {
-                    if (current_color != -1) {
-                        ab.append("\x1b[39m", 5);
-                        current_color = -1;
-                    }
-                    ab.append(&c[j], 1);
-                } else {
-                    int color = editorSyntaxToColor(hl[j]);
-                    if (color != current_color) {
-                        current_color = color;
-                        char seq[16];
-                        int n = snprintf(seq, sizeof(seq), "\x1b[1;%dm", color);
-                        ab.append(seq, n);
-                    }
-                    ab.append(&c[j], 1);
-                }
+        } else if (_B->wrap_width) {
+            bool selected = fileRow >= sel_from && fileRow <= sel_to;
+            if (selected) ab += "\x1b[7m";
+            _B->editorDrawRow(ab, fileRow, sub * _B->wrap_width, _B->wrap_width);
+            if (selected) ab += "\x1b[m";
+            if (++sub >= _B->editorRowWrapCount(&_B->rows[fileRow])) {
+                fileRow++;
+                sub = 0;
             }
-            ab.append("\x1b[39m", 5);
+        } else {
+            bool selected = fileRow >= sel_from && fileRow <= sel_to;
+            if (selected) ab += "\x1b[7m";
+            _B->editorDrawRow(ab, fileRow, _B->col_offset, editorTextCols());
+            if (selected) ab += "\x1b[m";
         }
             ab += "\x1b[K";
             ab += "\r\n";
     }
 }
 
+/* The rows from the mark to the cursor, or the cursor row alone. */
+bool Term::editorSelection(int *from, int *to) {
+    if (_B->numrows == 0) return false;
+    int cy = std::min(_B->cursor_y, _B->numrows - 1);
+    int my = _B->mark_y >= 0 ? std::min(_B->mark_y, _B->numrows - 1) : cy;
+    *from = std::min(cy, my);
+    *to = std::max(cy, my);
+    return true;
+}
+
+/* Whole-line commands: each is one bulk edit of the buffer, so a block of
+ * any size is re-rendered and re-lexed once. */
+void Term::editorRangeCommand(int key) {
+    if (key == CTRL_KEY('v')) {
+        if (clip.atoms.empty()) {
+            editorSetStatusMessage("Nothing to paste");
+            return;
+        }
+        int at = std::min(_B->cursor_y, _B->numrows);
+        _B->editorPasteRows(at, clip);
+        _B->cursor_y = at + clip.atoms.size();
+        _B->cursor_x = 0;
+        _B->mark_y = -1;
+        editorSetStatusMessage("%zu lines pasted", clip.atoms.size());
+        return;
+    }
+
+    int from, to;
+    if (!editorSelection(&from, &to)) return;
+    int n = to - from + 1;
+    switch (key) {
+    case CTRL_KEY('c'):
+        _B->editorCopyRows(from, to, clip);
+        _B->mark_y = -1;
+        editorSetStatusMessage("%d lines copied", n);
+        break;
+    case CTRL_KEY('x'):
+    case CTRL_KEY('y'):
+        if (key == CTRL_KEY('x')) _B->editorCopyRows(from, to, clip);
+        _B->editorDelRows(from, to);
+        _B->cursor_y = from;
+        _B->cursor_x = 0;
+        _B->mark_y = -1;
+        editorSetStatusMessage(key == CTRL_KEY('x') ? "%d lines cut" : "%d lines deleted", n);
+        break;
+    case ALT_ARROW_UP:
+    case ALT_ARROW_DOWN:
+    {
+        int by = key == ALT_ARROW_UP ? -1 : 1;
+        if (!_B->editorMoveRows(from, to, by)) break;
+        _B->cursor_y += by;
+        if (_B->mark_y >= 0) _B->mark_y += by;
+        break;
+    }
+    case '\t':
+    case SHIFT_TAB:
+        _B->editorIndentRows(from, to, key == SHIFT_TAB);
+        if (_B->cursor_y < _B->numrows) {
+            trow_ *row = &_B->rows[_B->cursor_y];
+            _B->cursor_x = _B->editorRowCharStart(row, std::min(_B->cursor_x, row->size));
+        }
+        break;
+    }
+}
+
 void Term::editorScroll() {
+    PERF_SCOPE(PERF_SCROLL);
     _C.r_x = 0;
-    if (_C.cursor_y < _C.numrows) _C.r_x = editorRowCxToRx(&_C.row[_C.cursor_y], _C.cursor_x);
+    if (_B->cursor_y < _B->numrows) _C.r_x = _B->editorRowCxToRx(&_B->rows[_B->cursor_y], _B->cursor_x);
+
+    if (_B->wrap_width) {
+        /* Scroll in visual lines; the top is kept as a row and a segment of
+         * it so that a resize does not move the view. */
+        int cur = editorCursorVisual();
+        int top = _B->editorVisualLine(std::min(_B->row_offset, _B->numrows));
+        if (_B->row_offset < _B->numrows) {
+            top += std::min(_C.wrap_sub, _B->editorRowWrapCount(&_B->rows[_B->row_offset]) - 1);
+        }
+        if (cur < top) top = cur;
+        if (cur >= top + _C.screen_rows) top = cur - _C.screen_rows + 1;
+
+        _B->row_offset = _B->editorRowAtVisual(top, &_C.wrap_sub);
+        _B->col_offset = 0;
+        _C.cursor_sy = cur - top;
+        _C.cursor_sx = editorGutter() + (_B->cursor_y < _B->numrows ?
+            _C.r_x - _B->editorRowWrapSub(&_B->rows[_B->cursor_y], _C.r_x) * _B->wrap_width : 0);
+        return;
+    }
+
+    if (_B->cursor_y < _B->row_offset) _B->row_offset = _B->cursor_y;
+    if (_B->cursor_y >= _B->row_offset + _C.screen_rows) _B->row_offset = _B->cursor_y - _C.screen_rows + 1;
+    if (_C.r_x < _B->col_offset) _B->col_offset = _C.r_x;
+    if (_C.r_x >= _B->col_offset + editorTextCols()) _B->col_offset = _C.r_x - editorTextCols() + 1;
+    _C.wrap_sub = 0;
+    _C.cursor_sy = _B->cursor_y - _B->row_offset;
+    _C.cursor_sx = editorGutter() + _C.r_x - _B->col_offset;
+}
+
+int Term::editorCursorVisual() {
+    if (_B->cursor_y >= _B->numrows) return _B->editorVisualLines();
+    trow_ *row = &_B->rows[_B->cursor_y];
+    int rx = _B->editorRowCxToRx(row, _B->cursor_x);
+    return _B->editorVisualLine(_B->cursor_y) + _B->editorRowWrapSub(row, rx);
+}
+
+/* Puts the cursor on visual line v, keeping its column within the segment. */
+void Term::editorMoveVisual(int v) {
+    int col = 0;
+    if (_B->cursor_y < _B->numrows) {
+        trow_ *row = &_B->rows[_B->cursor_y];
+        int rx = _B->editorRowCxToRx(row, _B->cursor_x);
+        col = rx - _B->editorRowWrapSub(row, rx) * _B->wrap_width;
+    }
 
-    if (_C.cursor_y < _C.row_offset) _C.row_offset = _C.cursor_y;
-    if (_C.cursor_y >= _C.row_offset + _C.screen_rows) _C.row_offset = _C.cursor_y - _C.screen_rows + 1;
-    if (_C.r_x < _C.col_offset) _C.col_offset = _C.r_x;
-    if (_C.r_x >= _C.col_offset + _C.screen_cols) _C.col_offset = _C.r_x - _C.screen_cols + 1;
+    if (v < 0) v = 0;
+    if (v >= _B->editorVisualLines()) {
+        _B->cursor_y = _B->numrows;
+        _B->cursor_x = 0;
+        return;
+    }
+    int sub;
+    _B->cursor_y = _B->editorRowAtVisual(v, &sub);
+    _B->cursor_x = _B->editorRowRxToCx(&_B->rows[_B->cursor_y], sub * _B->wrap_width + col);
+}
+
+void Term::editorSetWrap(bool on) {
+    _B->editorSetWrap(on ? editorTextCols() : 0);
+    _C.wrap_sub = 0;
 }
 
 int Term::getWindowSize(int *rows, int *cols) {
@@ -385,150 +711,171 @@ int Term::getCursorPosition(int *rows, int *cols) {
 }
 
 void Term::initEditor() {
-    _C.cursor_x = 0;
-    _C.cursor_y = 0;
     _C.r_x = 0;
-    _C.row_offset = 0;
-    _C.col_offset = 0;
-    _C.numrows = 0;
-    _C.row = NULL;
-    _C.filename = NULL;
-    _C.dirty = 0;
+    _C.wrap_sub = 0;
     _C.statusMsg[0] = '\0';
     _C.statusMsg_time = 0;
-    _C.syntax = NULL;
 
     if (getWindowSize(&_C.screen_rows, &_C.screen_cols) == -1) die("getWindowSize");
+    abuf.reserve((size_t)_C.screen_rows * _C.screen_cols * 4);
     _C.screen_rows -= 2;
+    if (cfg.config.soft_wrap) editorSetWrap(true);
 }
 
 void Term::editorMoveCursor(int key) {
-    trow_ *row = (_C.cursor_y >= _C.numrows) ? NULL : &_C.row[_C.cursor_y];
+    trow_ *row = (_B->cursor_y >= _B->numrows) ? NULL : &_B->rows[_B->cursor_y];
 
     switch (key) {
     case CTRL_ARROW_LEFT:
-        _C.cursor_x = 0;
+        _B->cursor_x = 0;
         break;    
     case ARROW_LEFT:
-        if (_C.cursor_x > 0) _C.cursor_x--;
-        else if (_C.cursor_y > 0) {
-            _C.cursor_y--;
-            _C.cursor_x = _C.row[_C.cursor_y].size;
+        if (_B->cursor_x > 0) _B->cursor_x = _B->editorRowPrevChar(row, _B->cursor_x);
+        else if (_B->cursor_y > 0) {
+            _B->cursor_y--;
+            _B->cursor_x = _B->rows[_B->cursor_y].size;
         }
         break;
     case ARROW_RIGHT:
-        if (row && _C.cursor_x < row->size) {
-            _C.cursor_x++;
-        } else if (row && _C.cursor_x == row->size) {
-            _C.cursor_y++;
-            _C.cursor_x = 0;
+        if (row && _B->cursor_x < row->size) {
+            _B->cursor_x = _B->editorRowNextChar(row, _B->cursor_x);
+        } else if (row && _B->cursor_x == row->size) {
+            _B->cursor_y++;
+            _B->cursor_x = 0;
         }
         break;
     case ARROW_UP:
-        if (_C.cursor_y > 0) _C.cursor_y--;
+        if (_B->wrap_width) editorMoveVisual(editorCursorVisual() - 1);
+        else if (_B->cursor_y > 0) _B->cursor_y--;
         break;
     case ARROW_DOWN:
-        if (_C.cursor_y < _C.numrows) _C.cursor_y++;
+        if (_B->wrap_width) editorMoveVisual(editorCursorVisual() + 1);
+        else if (_B->cursor_y < _B->numrows) _B->cursor_y++;
         break;
     }
 
-    row = (_C.cursor_y >= _C.numrows) ? NULL : &_C.row[_C.cursor_y];
+    row = (_B->cursor_y >= _B->numrows) ? NULL : &_B->rows[_B->cursor_y];
     int rowLen = row ? row->size : 0;
-    if (_C.cursor_x > rowLen) _C.cursor_x = rowLen;
+    if (_B->cursor_x > rowLen) _B->cursor_x = rowLen;
+    if (row) _B->cursor_x = _B->editorRowCharStart(row, _B->cursor_x);
 
-    _C.r_x = row ? editorRowCxToRx(row, _C.cursor_x) : 0;
+    _C.r_x = row ? _B->editorRowCxToRx(row, _B->cursor_x) : 0;
 }
 
 
-void Term::editorInsertRow(int at, char *s, size_t len) {
-    if (at < 0 || at > _C.numrows) return;
-
-    _C.row = (trow_*)realloc(_C.row, sizeof(trow_) * (_C.numrows + 1));
-    memmove(&_C.row[at + 1], &_C.row[at], sizeof(trow_) * (_C.numrows - at));
-    for (int j = at + 1; j <= _C.numrows; j++) _C.row[j].idx++;
-
-    _C.row[at].idx = at;
-
-    _C.row[at].size = len;
-    _C.row[at].chars = (char*)malloc(len + 1);
-    memcpy(_C.row[at].chars, s, len);
-    _C.row[at].chars[len] = '\0';
-
-    _C.row[at].r_size = 0;
-    _C.row[at].render = NULL;
-    _C.row[at].hl = NULL;
-    _C.row[at].hl_open_comment = 0;
-    editorUpdateRow(&_C.row[at]);
-
-    _C.numrows++;
-    _C.dirty ++;
+/* The first file goes into the empty start-up buffer, later ones are only
+ * read when switched to. */
+void Term::editorOpen(char* filename) {
+    if (_B->filename || _B->numrows) {
+        editorAddBuffer(filename);
+        return;
+    }
+    if (_B->editorOpen(filename) == -1) die("fopen");
+    if (cfg.config.rss_target_mb > 0) reclaim_pending = true;
+    if (_B->recovered) editorSetStatusMessage("Recovered %d unsaved edits from journal", _B->recovered);
+    if (_B->journal_busy) editorSetStatusMessage("%s is open in another edi; edits here are not journaled", filename);
 }
 
-void Term::editorUpdateRow(trow_ *row) {
-    int tabs = 0;
-    int j;
-    for (j = 0; j < row->size; j++) if (row->chars[j] == '\t') tabs++;
-
-    free(row->render);
-    row->render = (char*)malloc(row->size + (tabs * (cfg.config.tab_stop - 1)) + 1);
+/*** buffers ***/
+size_t Term::editorAddBuffer(const char *filename) {
+    BufferSlot slot;
+    slot.buffer.reset(new Buffer());
+    slot.buffer->dataDir = configDir.string();
+    if (filename) slot.buffer->filename = strdup(filename);
+    slot.loaded = !filename;
+    slot.last_used = 0;
+    slot.derived = 0;
+    buffers.push_back(std::move(slot));
+    return buffers.size() - 1;
+}
 
-    int idx = 0;
-    for (int j = 0; j < row->size; j++) { 
-        if (row->chars[j] == '\t') {
-            row->render[idx++] = ' ';
-            while (idx % cfg.config.tab_stop != 0) row->render[idx++] = ' ';
-        } else {
-            row->render[idx++] = row->chars[j];
-        }
+void Term::editorSwitchBuffer(size_t at) {
+    bool wrap = _B && _B->wrap_width;
+    if (_B) buffers[current].derived = _B->editorDerivedBytes();
+    BufferSlot &slot = buffers[at];
+    current = at;
+    _B = slot.buffer.get();
+    slot.last_used = ++use_clock;
+    _C.wrap_sub = 0;
+
+    if (!slot.loaded) {
+        slot.loaded = true;
+        if (wrap) _B->wrap_width = editorTextCols();
+        char *filename = strdup(_B->filename);
+        if (_B->editorOpen(filename) == -1) editorSetStatusMessage("New file %s: %s", filename, strerror(errno));
+        else if (_B->journal_busy) editorSetStatusMessage("%s is open in another edi; edits here are not journaled", filename);
+        else if (_B->recovered) editorSetStatusMessage("Recovered %d unsaved edits from journal", _B->recovered);
+        free(filename);
     }
-    row->render[idx] = '\0';
-    row->r_size = idx;
-
-    editorUpdateSyntax(row);
+    if (_B->wrap_width && _B->wrap_width != editorTextCols()) _B->editorSetWrap(editorTextCols());
+    if (cfg.config.rss_target_mb > 0 || cfg.config.cache_budget_mb > 0) reclaim_pending = true;
 }
 
-void Term::editorOpen(char* filename) {
-    free(_C.filename);
-    _C.filename = strdup(filename);
-
-    editorSelectSyntaxHighlight();
-
-    FILE *file = fopen(filename, "r");
-    if (!file) die("fopen");
-
-    char *line = NULL;
-    size_t lineCap = 0;
-    ssize_t lineLen;
-    while ((lineLen = getline(&line, &lineCap, file)) != -1) {
-        while (lineLen > 0 && (line[lineLen - 1] == '\n' ||
-                               line[lineLen - 1] == '\r')) {
-            lineLen--;
-        }
-        editorInsertRow(_C.numrows, line, lineLen);
+void Term::editorOpenPrompt() {
+    char *filename = editorPrompt((char*)"Open: %s", NULL);
+    if (filename == NULL) {
+        editorSetStatusMessage("Open aborted");
+        return;
     }
-    free(line);
-    fclose(file);
-    _C.dirty = 0;
+    size_t at = 0;
+    while (at < buffers.size() && !(buffers[at].buffer->filename &&
+           !strcmp(buffers[at].buffer->filename, filename))) at++;
+    if (at == buffers.size()) at = editorAddBuffer(filename);
+    free(filename);
+    editorSwitchBuffer(at);
 }
 
-int Term::editorRowCxToRx(trow_ *row, int cx) {
-    int rx = 0;
-    int j;
-    for (j = 0; j < cx; j++) {
-        if (row->chars[j] == '\t') rx += (cfg.config.tab_stop - 1) - (rx % cfg.config.tab_stop);
-        rx++;
+/* Over cache_budget_mb, drops render and hl of the least recently shown
+ * buffers first, each keeping the screen it was left on. The current buffer
+ * is trimmed last and only when the others are not enough. */
+void Term::editorTrimCaches() {
+    size_t budget = (size_t)cfg.config.cache_budget_mb << 20;
+    if (!budget) return;
+
+    buffers[current].derived = _B->editorDerivedBytes();
+    std::vector<size_t> order;
+    size_t total = 0;
+    for (size_t j = 0; j < buffers.size(); j++) {
+        if (!buffers[j].loaded) continue;
+        total += buffers[j].derived;
+        order.push_back(j);
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return buffers[a].last_used < buffers[b].last_used;
+    });
+
+    for (size_t j : order) {
+        if (total <= budget) break;
+        BufferSlot &slot = buffers[j];
+        Buffer *b = slot.buffer.get();
+        total -= slot.derived;
+        b->editorDropDerived(b->row_offset, b->row_offset + _C.screen_rows);
+        slot.derived = b->editorDerivedBytes();
+        total += slot.derived;
     }
-    return rx;
+}
+
+int Term::editorDirtyBuffers() {
+    int n = 0;
+    for (BufferSlot &slot : buffers) if (slot.buffer->dirty) n++;
+    return n;
 }
 
 void Term::editorDrawStatusBar(std::string &ab) {
     ab.append("\x1b[7m", 4);
-    char status[80], rstatus[80];
-    int len = snprintf(status, sizeof(status), "%.80s - %d lines %s", 
-        _C.filename ? _C.filename : "[No Name]", _C.numrows,
-        _C.dirty ? "(modified)" : "");
-    int rlen = snprintf(rstatus, sizeof(rstatus), "%s | %d/%d",
-        _C.syntax ? _C.syntax->filetype : "no ft", _C.cursor_y + 1, _C.numrows);
+    char status[96], rstatus[80], tag[24] = "";
+    if (buffers.size() > 1) snprintf(tag, sizeof(tag), "[%zu/%zu] ", current + 1, buffers.size());
+    int len = snprintf(status, sizeof(status), "%s%.70s - %d lines %s",
+        tag, _B->filename ? _B->filename : "[No Name]", _B->numrows,
+        _B->dirty ? "(modified)" : "");
+    if (_B->diff.active() && len < (int)sizeof(status)) {
+        len += snprintf(status + len, sizeof(status) - len, " +%d ~%d -%d",
+            _B->diff.added, _B->diff.changed, _B->diff.deleted);
+    }
+    if (len >= (int)sizeof(status)) len = sizeof(status) - 1;
+    int rlen = snprintf(rstatus, sizeof(rstatus), "%s | %d/%d @%llu",
+        _B->syntax ? _B->syntax->filetype : "no ft", _B->cursor_y + 1, _B->numrows,
+        (unsigned long long)_B->editorCursorOffset());
     if (len > _C.screen_cols) len = _C.screen_cols;
     ab.append(status, len);
     while (len < _C.screen_cols) {
@@ -552,136 +899,51 @@ void Term::editorSetStatusMessage(const char *fmt, ...) {
     _C.statusMsg_time = time(NULL);
 }
 
+/* A fresh status message, prompts included, wins over the overlay. */
 void Term::editorDrawMessageBar(std::string &ab) {
     ab.append("\x1b[K", 3);
     int msgLen = strlen(_C.statusMsg);
     if (msgLen > _C.screen_cols) msgLen = _C.screen_cols;
-    if (msgLen && time(NULL) - _C.statusMsg_time < 7) ab.append(_C.statusMsg, msgLen);
-}
-
-void Term::editorRowInsertChar(trow_ *row, int at, int c) {
-    if (at < 0 || at > row->size) at = row->size;
-    row->chars = (char*)realloc(row->chars, row->size + 2);
-    memmove(&row->chars[at + 1], &row->chars[at], row->size - at + 1);
-    row->size++;
-    row->chars[at] = c;
-    editorUpdateRow(row);
-    _C.dirty++;
-}
-
-void Term::editorInsertChar(int c) {
-    if (_C.cursor_y == _C.numrows) editorInsertRow(_C.numrows, (char*)"", 0);
-    editorRowInsertChar(&_C.row[_C.cursor_y], _C.cursor_x, c);
-    _C.cursor_x++;
-}
-
-char *Term::editorRowToString(int *buflen) {
-    int total_len = 0;
-    int j;
-    for (j = 0; j < _C.numrows; j++) total_len += _C.row[j].size + 1;
-    *buflen = total_len;
-
-    char *buf = (char*)malloc(total_len);
-    char *p = buf;
-    for (j = 0; j < _C.numrows; j++) {
-        memcpy(p, _C.row[j].chars, _C.row[j].size);
-        p += _C.row[j].size;
-        *p = '\n';
-        p++;
+    if (msgLen && time(NULL) - _C.statusMsg_time < STATUS_MSG_SECONDS) {
+        ab.append(_C.statusMsg, msgLen);
+        return;
+    }
+    if (perf.enabled) {
+        char overlay[384];
+        perf.overlay(overlay, sizeof(overlay));
+        int len = strlen(overlay);
+        len += snprintf(overlay + len, sizeof(overlay) - len, " | tty %.1fM/s merged %llu stalls %llu",
+            output.throughput() / 1048576.0, (unsigned long long)output.stats.merged,
+            (unsigned long long)output.stats.stalls);
+        if (len >= (int)sizeof(overlay)) len = sizeof(overlay) - 1;
+        if (cfg.config.rss_target_mb > 0) {
+            const ColdStats &cs = _B->cold.stats;
+            uint64_t lookups = cs.hits + cs.misses;
+            len += snprintf(overlay + len, sizeof(overlay) - len,
+                " | rss %lluM cold %llu rows %.1f->%.1fM hit %.0f%%",
+                (unsigned long long)(perfRss() >> 20), (unsigned long long)cs.rows,
+                cs.raw_bytes / 1048576.0, cs.packed_bytes / 1048576.0,
+                lookups ? 100.0 * cs.hits / lookups : 100.0);
+            if (len >= (int)sizeof(overlay)) len = sizeof(overlay) - 1;
+        }
+        if (len > _C.screen_cols) len = _C.screen_cols;
+        ab.append(overlay, len);
     }
-
-    return buf;
 }
 
 void Term::editorSave() {
-    if (_C.filename == NULL){
-        _C.filename = editorPrompt((char*)"Save as: %s", NULL);
-        if (_C.filename == NULL) {
+    if (_B->filename == NULL){
+        _B->filename = editorPrompt((char*)"Save as: %s", NULL);
+        if (_B->filename == NULL) {
             editorSetStatusMessage("Save aborted");
             return;
         }
-        editorSelectSyntaxHighlight();
-    }
-
-    int len;
-    char *buf = editorRowToString(&len);
-
-    int fd = open(_C.filename, O_RDWR | O_CREAT, 0644);
-    if (fd != -1) {
-        if (ftruncate(fd, len) != -1) {
-            if (write(fd, buf, len) == len) {
-                close(fd);
-                free(buf);
-                editorSetStatusMessage("%d bytes written to disk", len);
-                return;
-            }
-        }
-        close(fd);
-    }
-    free(buf);
-    editorSetStatusMessage("Oops. I/O error: %s", strerror(errno));
-}
-
-void Term::editorRowDeleteChar(trow_ *row, int at) {
-    if (at < 0 || at >= row->size) return;
-    memmove(&row->chars[at], &row->chars[at+1], row->size - at);
-    row->size--;
-    editorUpdateRow(row);
-    _C.dirty++;
-}
-
-void Term::editorDelChar() {
-    if (_C.cursor_y == _C.numrows) return;
-    if (_C.cursor_x == 0 && _C.cursor_y == 0) return;
-
-    trow_ *row = &_C.row[_C.cursor_y];
-    if (_C.cursor_x > 0) {
-        editorRowDeleteChar(row, _C.cursor_x - 1);
-        _C.cursor_x--;
-    } else {
-        _C.cursor_x = _C.row[_C.cursor_y - 1].size;
-        editorRowAppendString(&_C.row[_C.cursor_y - 1], row->chars, row->size);
-        editorDelRow(_C.cursor_y);
-        _C.cursor_y--;
+        _B->editorSelectSyntaxHighlight();
     }
-}
-
-void Term::editorFreeRow(trow_ *row) {
-    free(row->render);
-    free(row->chars);
-    free(row->hl);
-}
 
-void Term::editorDelRow(int at) {
-    if (at < 0 || at >= _C.numrows) return;
-    editorFreeRow(&_C.row[at]);
-    memmove(&_C.row[at], &_C.row[at + 1], sizeof(trow_) * (_C.numrows - at - 1));
-    for (int j = at; j < _C.numrows - 1; j++) _C.row[j].idx--;
-    _C.numrows--;
-    _C.dirty++;
-}
-
-void Term::editorRowAppendString(trow_ *row, char *s, size_t len) {
-    row->chars = (char *)realloc(row->chars, row->size + len + 1);
-    memcpy(&row->chars[row->size], s, len);
-    row->size += len;
-    row->chars[row->size] = '\0';
-    editorUpdateRow(row);
-    _C.dirty++;
-}
-
-void Term::editorInsertNewLine() {
-    if (_C.cursor_x == 0) editorInsertRow(_C.cursor_y, (char*)"", 0);
-    else {
-        trow_ *row = &_C.row[_C.cursor_y];
-        editorInsertRow(_C.cursor_y + 1, &row->chars[_C.cursor_x], row->size - _C.cursor_x);
-        row = &_C.row[_C.cursor_y];
-        row->size = _C.cursor_x;
-        row->chars[row->size] = '\0';
-        editorUpdateRow(row);
-    }
-    _C.cursor_y++;
-    _C.cursor_x = 0;
+    int64_t len = _B->editorSave();
+    if (len == -1) editorSetStatusMessage("Oops. I/O error: %s", strerror(errno));
+    else editorSetStatusMessage("%lld bytes written to disk", (long long)len);
 }
 
 char *Term::editorPrompt(char *prompt, std::function<void(char*, int)> callback) {
@@ -722,10 +984,10 @@ char *Term::editorPrompt(char *prompt, std::function<void(char*, int)> callback)
 }
 
 void Term::editorFind() {
-    int saved_cx = _C.cursor_x;
-    int saved_cy = _C.cursor_y;
-    int saved_coloff = _C.col_offset;
-    int saved_rowoff = _C.row_offset;
+    int saved_cx = _B->cursor_x;
+    int saved_cy = _B->cursor_y;
+    int saved_coloff = _B->col_offset;
+    int saved_rowoff = _B->row_offset;
 
     char *query = editorPrompt(
         (char*)"Search: %s (HELP: ESC/Arrows/Enter)",
@@ -734,10 +996,10 @@ void Term::editorFind() {
 
     if (query) free(query);
     else {
-        _C.cursor_x = saved_cx;
-        _C.cursor_y = saved_cy;
-        _C.col_offset = saved_coloff;
-        _C.row_offset = saved_rowoff;
+        _B->cursor_x = saved_cx;
+        _B->cursor_y = saved_cy;
+        _B->col_offset = saved_coloff;
+        _B->row_offset = saved_rowoff;
     }
 }
 
@@ -745,14 +1007,26 @@ void Term::editorFindCallback(char *query, int key) {
     static int last_match = -1;
     static int direction = 1;
 
+    /* The match highlight is undone only in the buffer and row it was put
+     * in, and only while the row still has the same render. */
+    static Buffer *saved_hl_buffer = NULL;
     static int saved_hl_line;
+    static int saved_hl_size;
     static char *saved_hl = NULL;
 
     if (saved_hl) {
-        memcpy(_C.row[saved_hl_line].hl, saved_hl, _C.row[saved_hl_line].r_size);
+        if (saved_hl_buffer == _B && saved_hl_line < _B->numrows) {
+            trow_ *row = &_B->rows[saved_hl_line];
+            if (row->hl && row->r_size == saved_hl_size) memcpy(_B->editorRowOwnHl(row), saved_hl, row->r_size);
+        }
         free(saved_hl);
         saved_hl = NULL;
     }
+    if (saved_hl_buffer != _B) {
+        saved_hl_buffer = _B;
+        last_match = -1;
+        direction = 1;
+    }
 
     if (key == '\r' || key == '\x1b') {
         last_match = -1;
@@ -767,192 +1041,89 @@ void Term::editorFindCallback(char *query, int key) {
     }
 
     if (last_match == -1) direction = 1;
-    int curr = last_match;
-    for (int i = 0; i < _C.numrows; i++) {
-        curr += direction;
-        if (curr == -1) curr = _C.numrows - 1;
-        else if (curr == _C.numrows) curr = 0;
-
-        trow_ *row = &_C.row[curr];
-        char *match = strstr(row->render, query);
-        if (match) {
-            last_match = curr;
-            _C.cursor_y = curr;
-            _C.cursor_x = editorRowRxToCx(row, match - row->render);
-            _C.row_offset = _C.numrows;
-
-            saved_hl_line = curr;
-            saved_hl = (char *)malloc(row->r_size);
-            memcpy(saved_hl, row->hl, row->r_size);
-            memset(&row->hl[match - row->render], HL_MATCH, strlen(query));
-            break;
-        }
+    int match_rx;
+    int curr = _B->editorFindNext(query, last_match, direction, &match_rx);
+    if (curr != -1) {
+        trow_ *row = &_B->rows[curr];
+        last_match = curr;
+        _B->cursor_y = curr;
+        _B->cursor_x = _B->editorRowRenderToCx(row, match_rx);
+        _B->row_offset = _B->numrows;
+
+        saved_hl_line = curr;
+        saved_hl_size = row->r_size;
+        saved_hl = (char *)malloc(row->r_size);
+        memcpy(saved_hl, _B->editorRowOwnHl(row), row->r_size);
+        memset(&row->hl[match_rx], HL_MATCH, strlen(query));
     }
 }
 
-int Term::editorRowRxToCx(trow_ *row, int rx) {
-    int cur_rx = 0;
-    int cx;
-    for (cx = 0; cx < row->size; cx++) {
-        if (row->chars[cx] == '\t') cur_rx += (cfg.config.tab_stop - 1) - (cur_rx % cfg.config.tab_stop);
-        cur_rx++;
-
-        if (cur_rx > rx) return cx;
+/* A line number, or @ and a byte offset as reported by compilers and
+ * crash dumps. */
+void Term::editorGoto() {
+    char *where = editorPrompt((char*)"Go to line or @offset: %s", NULL);
+    if (where == NULL) return;
+
+    uint64_t offset;
+    int line;
+    if (where[0] == '@' && Buffer::parseOffset(where + 1, &offset) == 0) {
+        _B->editorGotoOffset(offset);
+    } else if (where[0] != '@' && Buffer::parseLine(where, &line) == 0) {
+        _B->cursor_y = std::min(line - 1, _B->numrows);
+        _B->cursor_x = 0;
+    } else {
+        editorSetStatusMessage("Bad position: %s", where);
+        free(where);
+        return;
     }
-    return cx;
+    free(where);
+    _B->row_offset = _B->numrows;
 }
 
-void Term::editorUpdateSyntax(trow_ *row) {
-    row->hl = (unsigned char *)realloc(row->hl, row->r_size);
-    memset(row->hl, HL_NORMAL, row->r_size);
-
-    if (_C.syntax == NULL) return;
-
-    const char **keywords = _C.syntax->keywords;
-
-    const char *scs = _C.syntax->single_line_comment_start;
-    const char *mcs = _C.syntax->multiline_comment_start;
-    const char *mce = _C.syntax->multiline_comment_end;
-
-    int scs_len = scs ? strlen(scs) : 0;
-    int mcs_len = mcs ? strlen(mcs) : 0;
-    int mce_len = mce ? strlen(mce) : 0;
-
-    bool prev_sep = 1;
-    bool in_string = 0;
-    bool in_comment = (row->idx > 0 && _C.row[row->idx - 1].hl_open_comment);
-
-    int i = 0;
-    while (i < row->r_size) {
-        char c = row->render[i];
-        unsigned char prev_hl = (i > 0) ? row->hl[i - 1] : (unsigned char)HL_NORMAL;
-
-        if (scs_len && !in_string && !in_comment) {
-            if (!strncmp(&row->render[i], scs, scs_len)) {
-                memset(&row->hl[i], HL_COMMENT, row->r_size - i);
-                break;
-            }
-        }
-
-        if (mcs_len && mce_len && !in_string) {
-            if (in_comment) {
-                row->hl[i] = HL_MLCOMMENT;
-                if (!strncmp(&row->render[i], mce, mce_len)) {
-                    memset(&row->hl[i], HL_MLCOMMENT, mce_len);
-                    i += mce_len;
-                    in_comment = 0;
-                    prev_sep = 1;
-                    continue;
-                } else {
-                    i++;
-                    continue;
-                }
-            } else if (!strncmp(&row->render[i], mcs, mcs_len)) {
-                memset(&row->hl[i], HL_MLCOMMENT, mcs_len);
-                i += mcs_len;
-                in_comment = 1;
-                continue;
-            }
-        }
-
-        if (_C.syntax->flags & HL_HIGHLIGHT_STRINGS) {
-            if (in_string) {
-                row->hl[i] = HL_STRING;
-                if (c == '\\' && i + 1 < row->r_size) {
-                    row->hl[i + 1] = HL_STRING;
-                    i += 2;
-                    continue;
-                }
-                if (c == in_string) in_string = 0;
-                i++;
-                prev_sep = 1;
-                continue;
-            } else if (c == '"' || c == '\'') {
-                in_string = c;
-                row->hl[i] = HL_STRING;
-                i++;
-                continue;
-            }
-        }
-
-        if(_C.syntax->flags & HL_HIGHLIGHT_NUMBERS) {
-            if ((isdigit(c) && (prev_sep || prev_hl == HL_NUMBER)) ||
-                    (c == '.' && prev_hl == HL_NUMBER)){
-                row->hl[i] = HL_NUMBER;
-                i++;
-                prev_sep = 0;
-                continue;
-            }
-        }
-
-        if (prev_sep) {
-            int j;
-            for (j = 0; keywords[j]; j++) {
-                int klen = strlen(keywords[j]);
-                int kw2 = keywords[j][klen - 1] == '|';
-                if (kw2) klen--;
-
-                if (!strncmp(&row->render[i], keywords[j], klen) &&
-                        is_separator(row->render[i + klen])) {
-                    memset(&row->hl[i], kw2 ? HL_KEYWORD2 : HL_KEYWORD1, klen);
-                    i += klen;
-                    break;
-                }
-            }
-            if (keywords[j] != NULL) {
-                prev_sep = 0;
-                continue;
-            }
-        }
-
-        prev_sep = is_separator(c);
-        i++;
+/*** diff ***/
+/* The file on disk is read and hashed by the worker; the diff itself is
+ * computed when it is done and then kept current as rows are edited. */
+void Term::editorToggleDiff() {
+    if (_B->diff.active()) {
+        _B->diff.stop();
+        if (_B->wrap_width) _B->editorSetWrap(editorTextCols());
+        editorSetStatusMessage("Diff off");
+        return;
     }
-
-    int changed = (row->hl_open_comment != in_comment);
-    row->hl_open_comment = in_comment;
-    if (changed && row->idx + 1 < _C.numrows) editorUpdateSyntax(&_C.row[row->idx + 1]);
-}
-
-int Term::editorSyntaxToColor(int hl) {
-    switch (hl) {
-        case HL_MLCOMMENT:
-        case HL_COMMENT: return cfg.config.hl_comment;
-        case HL_KEYWORD1: return cfg.config.hl_keyword1;
-        case HL_KEYWORD2: return cfg.config.hl_keyword2;
-        case HL_NUMBER: return cfg.config.hl_number;
-        case HL_MATCH: return cfg.config.hl_match;
-        case HL_STRING: return cfg.config.hl_string;
-        default: return 37;
+    if (!_B->filename) {
+        editorSetStatusMessage("Nothing on disk to diff against");
+        return;
     }
+    if (diff_loading) return;
+
+    diff_loading = true;
+    Buffer *buffer = _B;
+    std::string path = _B->filename;
+    auto base = std::make_shared<std::vector<uint64_t>>();
+    auto err = std::make_shared<int>(0);
+    editorSetStatusMessage("Reading %.60s...", path.c_str());
+    loop.submit([path, base, err]() {
+        if (diffHashFile(path.c_str(), *base) == -1) *err = errno;
+    }, [this, buffer, base, err]() {
+        diff_loading = false;
+        if (*err) {
+            editorSetStatusMessage("Diff failed: %s", strerror(*err));
+            return;
+        }
+        buffer->editorDiffStart(std::move(*base));
+        if (buffer->wrap_width) buffer->editorSetWrap(_C.screen_cols - DIFF_GUTTER);
+        if (buffer == _B) editorSetStatusMessage("Diff against disk: +%d ~%d -%d",
+            buffer->diff.added, buffer->diff.changed, buffer->diff.deleted);
+    });
 }
 
-int Term::is_separator(int c) {
-    return isspace(c) || c == '\0' || strchr(",.()+-/*=~%<>[];", c) != NULL;
+/* Two columns left of the text with the row's change against the file on
+ * disk; deleted lines are marked on the row that follows them. */
+void Term::editorDrawGutter(std::string &ab, int at) {
+    const LineDiff &diff = _B->diff;
+    if (at < 0 || (at == _B->numrows && !diff.tail_deleted)) ab += "  ";
+    else if (at == _B->numrows || diff.deletedAbove(at)) ab += "\x1b[31m-\x1b[39m ";
+    else if (diff.kind(at) == DIFF_ADDED) ab += "\x1b[32m+\x1b[39m ";
+    else if (diff.kind(at) == DIFF_CHANGED) ab += "\x1b[33m~\x1b[39m ";
+    else ab += "  ";
 }
-
-void Term::editorSelectSyntaxHighlight() {
-    _C.syntax = NULL;
-    if (_C.filename == NULL) return;
-
-    char *ext = strrchr(_C.filename, '.');
-
-    for (unsigned int j = 0; j < HLDB_ENTRIES; j++) {
-        struct editorSyntax *s = &HLDB[j];
-        unsigned int i = 0;
-        while(s->filematch[i]) {
-            int is_ext = (s->filematch[i][0] == '.');
-            if ((is_ext && ext && !strcmp(ext, s->filematch[i])) ||
-                (!is_ext && strstr(_C.filename, s->filematch[i]))) {
-                _C.syntax = s;
-
-                int filerow;
-                for (filerow = 0; filerow < _C.numrows; filerow++) {
-                    editorUpdateSyntax(&_C.row[filerow]);
-                }
-                return;
-            }
-            i++;
-        }
-    }
-}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*** includes ***/
+#include "include/utf8.hpp"
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*** scanning ***/
+bool utf8IsAscii(const char *s, size_t len) {
+    size_t j = 0;
+    #ifdef __SSE2__
+    __m128i acc = _mm_setzero_si128();
+    for (; j + 16 <= len; j += 16) acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *)(s + j)));
+    if (_mm_movemask_epi8(acc)) return false;
+    #endif
+    uint64_t high = 0;
+    for (; j + 8 <= len; j += 8) {
+        uint64_t w;
+        memcpy(&w, s + j, 8);
+        high |= w;
+    }
+    for (; j < len; j++) high |= (unsigned char)s[j];
+    return !(high & 0x8080808080808080ULL);
+}
+
+/*** decoding ***/
+int utf8Decode(const char *s, size_t len, uint32_t *cp) {
+    const unsigned char *p = (const unsigned char *)s;
+    unsigned char c = p[0];
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+
+    int n;
+    uint32_t v;
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 2;
+        v = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        n = 3;
+        v = c & 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 4;
+        v = c & 0x07;
+    } else {
+        *cp = UTF8_INVALID;
+        return 1;
+    }
+    if ((size_t)n > len) {
+        *cp = UTF8_INVALID;
+        return 1;
+    }
+    for (int k = 1; k < n; k++) {
+        if ((p[k] & 0xC0) != 0x80) {
+            *cp = UTF8_INVALID;
+            return 1;
+        }
+        v = v << 6 | (p[k] & 0x3F);
+    }
+
+    /* Overlong forms, surrogates and values past U+10FFFF. */
+    if ((n == 3 && v < 0x800) || (n == 4 && (v < 0x10000 || v > 0x10FFFF)) ||
+        (v >= 0xD800 && v <= 0xDFFF)) {
+        *cp = UTF8_INVALID;
+        return 1;
+    }
+    *cp = v;
+    return n;
+}
+
+/*** width ***/
+struct Range { uint32_t first, last; };
+
+static const Range zero_width[] = {
+    { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x0610, 0x061A },
+    { 0x064B, 0x065F }, { 0x0E31, 0x0E31 }, { 0x0E34, 0x0E3A }, { 0x1AB0, 0x1AFF },
+    { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F }, { 0x20D0, 0x20FF }, { 0xFE00, 0xFE0F },
+    { 0xFE20, 0xFE2F }, { 0xE0100, 0xE01EF }
+};
+
+static const Range wide[] = {
+    { 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC },
+    { 0x25FD, 0x25FE }, { 0x2614, 0x2615 }, { 0x2648, 0x2653 }, { 0x26A1, 0x26A1 },
+    { 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26D4, 0x26D4 },
+    { 0x26EA, 0x26EA }, { 0x26F5, 0x26F5 }, { 0x26FA, 0x26FA }, { 0x26FD, 0x26FD },
+    { 0x2705, 0x2705 }, { 0x270A, 0x270B }, { 0x2728, 0x2728 }, { 0x274C, 0x274C },
+    { 0x2753, 0x2755 }, { 0x2757, 0x2757 }, { 0x2795, 0x2797 }, { 0x27B0, 0x27B0 },
+    { 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x303E },
+    { 0x3041, 0x33FF }, { 0x3400, 0x4DBF }, { 0x4E00, 0x9FFF }, { 0xA000, 0xA4CF },
+    { 0xA960, 0xA97F }, { 0xAC00, 0xD7A3 }, { 0xF900, 0xFAFF }, { 0xFE10, 0xFE19 },
+    { 0xFE30, 0xFE6F }, { 0xFF00, 0xFF60 }, { 0xFFE0, 0xFFE6 }, { 0x1F004, 0x1F004 },
+    { 0x1F0CF, 0x1F0CF }, { 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A }, { 0x1F200, 0x1F251 },
+    { 0x1F300, 0x1F64F }, { 0x1F680, 0x1F6FF }, { 0x1F7E0, 0x1F7EB }, { 0x1F90C, 0x1F9FF },
+    { 0x1FA70, 0x1FAFF }, { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD }
+};
+
+static bool inRanges(uint32_t cp, const Range *r, size_t n) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (cp < r[mid].first) hi = mid;
+        else if (cp > r[mid].last) lo = mid + 1;
+        else return true;
+    }
+    return false;
+}
+
+int utf8Width(uint32_t cp) {
+    if (cp < 0x20 || cp == 0x7F) return -1;
+    if (cp < 0x7F) return 1;
+    if (cp == UTF8_INVALID || cp < 0xA0) return -1;
+    if (inRanges(cp, zero_width, sizeof(zero_width) / sizeof(zero_width[0]))) return 0;
+    if (inRanges(cp, wide, sizeof(wide) / sizeof(wide[0]))) return 2;
+    return 1;
+}
@@ -0,0 +1,21 @@
+// check.hpp
+#pragma once
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <stdio.h>
+
+/* Tests are plain programs: every failed CHECK is printed and counted, and
+ * main returns CHECK_RESULT for ctest. */
+static int check_failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_RESULT (check_failures ? 1 : 0)
+
+#endif // CHECK_HPP
@@ -0,0 +1,84 @@
+/*** includes ***/
+#include "batch.hpp"
+#include "check.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+/*** helpers ***/
+static std::string dir;
+
+static std::string writeFile(const char *name, const std::string &text) {
+    std::string path = dir + "/" + name;
+    FILE *f = fopen(path.c_str(), "w");
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+    return path;
+}
+
+static std::string readFile(const std::string &path) {
+    std::string text;
+    FILE *f = fopen(path.c_str(), "r");
+    if (!f) return text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    fclose(f);
+    return text;
+}
+
+/* Runs script over one file holding text and returns what was saved. */
+static std::string runScript(const std::string &script, const std::string &text, int *status) {
+    std::string path = writeFile("text.txt", text);
+    Batch batch;
+    CHECK(batch.load(writeFile("script.edi", script).c_str()) == 0);
+    char *files[] = { &path[0] };
+    *status = batch.run(1, files);
+    return readFile(path);
+}
+
+/*** tests ***/
+static void testRepeatedFindMovesOn() {
+    int status;
+    std::string out = runScript("find foo\nfind foo\ninsert X\nsave\n", "foo foo foo\n", &status);
+    CHECK(status == 0);
+    CHECK(out == "foo Xfoo foo\n");
+
+    out = runScript("find foo\nfind foo\nfind foo\ninsert X\nsave\n", "foo\nbar foo\nfoo\n", &status);
+    CHECK(out == "foo\nbar foo\nXfoo\n");
+}
+
+static void testFindAtCursor() {
+    int status;
+    std::string out = runScript("find foo\ninsert X\nsave\n", "foo bar\n", &status);
+    CHECK(out == "Xfoo bar\n");
+
+    /* After an edit the next find starts at the cursor again. */
+    out = runScript("find b\ninsert X\nfind b\ninsert Y\nsave\n", "ab\n", &status);
+    CHECK(out == "aXYb\n");
+}
+
+static void testFindPastLastMatch() {
+    int status;
+    std::string out = runScript("find foo\nfind foo\ninsert X\nsave\n", "foo\n", &status);
+    CHECK(status == 0);
+    CHECK(out == "foo\n");
+}
+
+int main() {
+    char tmpl[] = "/tmp/edi_test_XXXXXX";
+    if (!mkdtemp(tmpl)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    dir = tmpl;
+
+    testRepeatedFindMovesOn();
+    testFindAtCursor();
+    testFindPastLastMatch();
+
+    std::string cmd = "rm -rf '" + dir + "'";
+    if (system(cmd.c_str()) != 0) perror("rm");
+    return CHECK_RESULT;
+}
@@ -0,0 +1,149 @@
+/*** includes ***/
+#include "diff.hpp"
+#include "check.hpp"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+/*** helpers ***/
+/* Lines stand in as their own hashes. */
+static std::vector<int> align(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b) {
+    std::vector<int> match(a.size());
+    diffLines(a.data(), a.size(), b.data(), b.size(), match.data());
+    return match;
+}
+
+/* A match must pair equal lines in increasing order on both sides. */
+static bool validMatch(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b,
+                       const std::vector<int> &match) {
+    int last = -1;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (match[i] < 0) continue;
+        if (match[i] <= last || match[i] >= (int)b.size() || a[i] != b[match[i]]) return false;
+        last = match[i];
+    }
+    return true;
+}
+
+/* Every row is same, changed or added, and every base line is matched,
+ * changed or deleted: the counts must add up on both sides. */
+static bool countsAddUp(const LineDiff &d, int rows, int base) {
+    int same = 0, added = 0, changed = 0, deleted = d.tail_deleted;
+    for (int j = 0; j < rows; j++) {
+        if (d.kind(j) == DIFF_SAME) same++;
+        else if (d.kind(j) == DIFF_ADDED) added++;
+        else changed++;
+        deleted += d.deletedAbove(j);
+    }
+    return added == d.added && changed == d.changed && deleted == d.deleted &&
+           same + changed + added == rows && same + changed + deleted == base;
+}
+
+/*** tests ***/
+static void testEmpty() {
+    std::vector<uint64_t> none, one = { 1 };
+    CHECK(align(none, none).empty());
+    CHECK(align(none, one).empty());
+    CHECK(align(one, none) == std::vector<int>({ -1 }));
+
+    LineDiff d;
+    d.start(std::vector<uint64_t>(), none);
+    CHECK(d.added == 0 && d.changed == 0 && d.deleted == 0);
+
+    d.start(std::vector<uint64_t>(one), none);
+    CHECK(d.deleted == 1 && d.tail_deleted == 1);
+    CHECK(countsAddUp(d, 0, 1));
+
+    d.start(std::vector<uint64_t>(), one);
+    CHECK(d.added == 1 && d.kind(0) == DIFF_ADDED);
+    CHECK(countsAddUp(d, 1, 0));
+}
+
+static void testSingleLine() {
+    std::vector<uint64_t> one = { 1 }, other = { 2 };
+    CHECK(align(one, one) == std::vector<int>({ 0 }));
+    CHECK(align(one, other) == std::vector<int>({ -1 }));
+
+    LineDiff d;
+    d.start(std::vector<uint64_t>(one), one);
+    CHECK(d.kind(0) == DIFF_SAME && d.added == 0 && d.changed == 0 && d.deleted == 0);
+
+    d.start(std::vector<uint64_t>(one), other);
+    CHECK(d.kind(0) == DIFF_CHANGED && d.changed == 1 && d.deleted == 0);
+
+    /* The line edited away and back again. */
+    std::vector<uint64_t> rows = other;
+    d.start(std::vector<uint64_t>(one), rows);
+    rows[0] = 1;
+    d.rowChanged(0);
+    d.update([&](int j) { return rows[j]; });
+    CHECK(d.kind(0) == DIFF_SAME && d.changed == 0);
+}
+
+static void testMoves() {
+    std::vector<uint64_t> a = { 1, 2, 3, 4, 5, 6 }, b = { 1, 5, 3, 4, 2, 6 };
+    std::vector<int> match = align(a, b);
+    CHECK(validMatch(a, b, match));
+    CHECK(match[0] == 0 && match[5] == 5);
+    CHECK(match[2] == 2 && match[3] == 3);
+}
+
+/* Random row edits applied incrementally keep the counts consistent with
+ * the marks after every update. */
+static void testRandomEdits() {
+    srand(11);
+    std::vector<uint64_t> base(400);
+    for (size_t j = 0; j < base.size(); j++) base[j] = 1 + rand() % 300;
+    std::vector<uint64_t> rows = base;
+
+    LineDiff d;
+    d.start(std::vector<uint64_t>(base), rows);
+    CHECK(d.added == 0 && d.changed == 0 && d.deleted == 0);
+
+    auto hashRow = [&](int j) { return rows[j]; };
+    for (int op = 0; op < 3000; op++) {
+        int r = rand() % 4;
+        if (r == 0 || rows.empty()) {
+            int at = rand() % (rows.size() + 1);
+            rows.insert(rows.begin() + at, 1000 + rand() % 50);
+            d.rowInserted(at);
+        } else if (r == 1) {
+            int at = rand() % rows.size();
+            rows.erase(rows.begin() + at);
+            d.rowDeleted(at);
+        } else if (r == 2) {
+            int at = rand() % rows.size();
+            rows[at] = 1000 + rand() % 50;
+            d.rowChanged(at);
+        } else {
+            int at = rand() % (rows.size() + 1);
+            int n = 1 + rand() % 5;
+            rows.insert(rows.begin() + at, n, 7);
+            d.rowsInserted(at, n);
+        }
+        if (rand() % 3 == 0) d.update(hashRow);
+        if (!d.pending()) CHECK(countsAddUp(d, rows.size(), base.size()));
+    }
+    d.update(hashRow);
+    CHECK(countsAddUp(d, rows.size(), base.size()));
+
+    /* Saved, then the first half deleted at once. */
+    d.rebase(rows);
+    CHECK(d.added == 0 && d.changed == 0 && d.deleted == 0);
+    int saved = rows.size();
+    int half = saved / 2;
+    rows.erase(rows.begin(), rows.begin() + half);
+    d.rowsDeleted(0, half);
+    d.update(hashRow);
+    CHECK(d.deleted == half && d.added == 0 && d.changed == 0);
+    CHECK(countsAddUp(d, rows.size(), saved));
+}
+
+int main() {
+    testEmpty();
+    testSingleLine();
+    testMoves();
+    testRandomEdits();
+    return CHECK_RESULT;
+}
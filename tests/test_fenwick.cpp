@@ -0,0 +1,125 @@
+/*** includes ***/
+#include "fenwick.hpp"
+#include "check.hpp"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+/*** helpers ***/
+static int64_t randomValue() {
+    return 1 + rand() % 50;
+}
+
+static std::vector<int64_t> randomValues(size_t n) {
+    std::vector<int64_t> v(n);
+    for (int64_t &x : v) x = randomValue();
+    return v;
+}
+
+/* Every prefix, value and search of f against a plain running sum over v;
+ * counts the mismatches so one bad state does not flood the output. */
+static int mismatches(const Fenwick<int64_t> &f, const std::vector<int64_t> &v) {
+    int bad = f.size() != v.size();
+    int64_t sum = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        bad += f.prefix(i) != sum;
+        bad += f.get(i) != v[i];
+        bad += f.find(sum) != i;
+        bad += f.find(sum + v[i] - 1) != i;
+        sum += v[i];
+    }
+    bad += f.prefix(v.size()) != sum;
+    bad += f.total() != sum;
+    bad += f.find(sum) != v.size();
+    return bad;
+}
+
+/*** tests ***/
+static void testEmpty() {
+    Fenwick<int64_t> f;
+    CHECK(f.size() == 0);
+    CHECK(f.total() == 0);
+    CHECK(f.prefix(0) == 0);
+    CHECK(f.find(0) == 0);
+
+    f.push_back(5);
+    f.erase(0);
+    CHECK(mismatches(f, {}) == 0);
+}
+
+/* Single inserts and erases across block splits and merges. */
+static void testRandomEdits() {
+    srand(3);
+    Fenwick<int64_t> f;
+    std::vector<int64_t> v;
+    for (int op = 0; op < 20000; op++) {
+        int r = rand() % 10;
+        if (r < 5 || v.empty()) {
+            size_t i = rand() % (v.size() + 1);
+            int64_t x = randomValue();
+            v.insert(v.begin() + i, x);
+            f.insert(i, x);
+        } else if (r < 9) {
+            size_t i = rand() % v.size();
+            v.erase(v.begin() + i);
+            f.erase(i);
+        } else {
+            size_t i = rand() % v.size();
+            int64_t x = randomValue();
+            v[i] = x;
+            f.set(i, x);
+        }
+        if (op % 499 == 0) CHECK(mismatches(f, v) == 0);
+    }
+    CHECK(mismatches(f, v) == 0);
+
+    /* Erased down to nothing and grown again. */
+    while (!v.empty()) {
+        size_t i = rand() % v.size();
+        v.erase(v.begin() + i);
+        f.erase(i);
+    }
+    CHECK(mismatches(f, v) == 0);
+    for (int j = 0; j < 600; j++) {
+        int64_t x = randomValue();
+        v.push_back(x);
+        f.push_back(x);
+    }
+    CHECK(mismatches(f, v) == 0);
+}
+
+static void testRangeEdits() {
+    srand(5);
+    Fenwick<int64_t> f;
+    std::vector<int64_t> v = randomValues(3000);
+    f.assign(std::vector<int64_t>(v));
+    CHECK(mismatches(f, v) == 0);
+
+    for (int op = 0; op < 2000; op++) {
+        if (rand() % 2 || v.empty()) {
+            size_t i = rand() % (v.size() + 1);
+            std::vector<int64_t> a = randomValues(rand() % 700);
+            v.insert(v.begin() + i, a.begin(), a.end());
+            f.insert(i, a);
+        } else {
+            size_t i = rand() % v.size();
+            size_t count = rand() % std::min<size_t>(v.size() - i + 1, 900);
+            v.erase(v.begin() + i, v.begin() + i + count);
+            f.erase(i, count);
+        }
+        if (op % 97 == 0) CHECK(mismatches(f, v) == 0);
+    }
+    CHECK(mismatches(f, v) == 0);
+
+    f.erase(0, v.size());
+    v.clear();
+    CHECK(mismatches(f, v) == 0);
+}
+
+int main() {
+    testEmpty();
+    testRandomEdits();
+    testRangeEdits();
+    return CHECK_RESULT;
+}
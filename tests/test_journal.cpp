@@ -0,0 +1,132 @@
+/*** includes ***/
+#include "buffer.hpp"
+#include "check.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+
+/*** helpers ***/
+static std::string dir;
+static std::string file;
+
+static void setUp() {
+    char tmpl[] = "/tmp/edi_test_XXXXXX";
+    if (!mkdtemp(tmpl)) {
+        perror("mkdtemp");
+        exit(1);
+    }
+    dir = tmpl;
+    mkdir((dir + "/data").c_str(), 0700);
+    file = dir + "/text.txt";
+    FILE *f = fopen(file.c_str(), "w");
+    for (int j = 0; j < 100; j++) fprintf(f, "line %d\n", j);
+    fclose(f);
+}
+
+static void tearDown() {
+    std::string cmd = "rm -rf '" + dir + "'";
+    if (system(cmd.c_str()) != 0) perror("rm");
+}
+
+static std::string journalPath() {
+    std::string jdir = dir + "/data/journal";
+    DIR *d = opendir(jdir.c_str());
+    if (!d) return "";
+    std::string found;
+    struct dirent *e;
+    while ((e = readdir(d))) {
+        if (strstr(e->d_name, ".journal")) found = jdir + "/" + e->d_name;
+    }
+    closedir(d);
+    return found;
+}
+
+static void openBuffer(Buffer &b) {
+    b.dataDir = dir + "/data";
+    CHECK(b.editorOpen(file.c_str()) == 0);
+}
+
+static std::string rowText(Buffer &b, int at) {
+    return std::string(b.editorRowText(&b.rows[at]), b.rows[at].size);
+}
+
+/*** tests ***/
+static void testSecondEditorGoesWithout() {
+    setUp();
+    {
+        Buffer first;
+        openBuffer(first);
+        CHECK(first.journal.active());
+        CHECK(!first.journal_busy);
+        first.editorRowSetText(&first.rows[0], "first", 5);
+        first.journal.commit();
+
+        {
+            Buffer second;
+            openBuffer(second);
+            CHECK(!second.journal.active());
+            CHECK(second.journal_busy);
+            CHECK(second.recovered == 0);
+            CHECK(rowText(second, 0) == "line 0");
+            second.editorRowSetText(&second.rows[1], "second", 6);
+            second.journal.discard();
+        }
+
+        first.editorRowSetText(&first.rows[2], "more", 4);
+        first.journal.commit();
+    }
+
+    /* Only the first editor's edits are in the journal, all of them. */
+    Buffer again;
+    openBuffer(again);
+    CHECK(again.journal.active());
+    CHECK(again.recovered == 2);
+    CHECK(rowText(again, 0) == "first");
+    CHECK(rowText(again, 1) == "line 1");
+    CHECK(rowText(again, 2) == "more");
+    tearDown();
+}
+
+static void testDamagedRecordEndsReplay() {
+    setUp();
+    {
+        Buffer b;
+        openBuffer(b);
+        for (int j = 0; j < 10; j++) {
+            std::string s = "set " + std::to_string(j);
+            b.editorRowSetText(&b.rows[j], s.data(), s.size());
+        }
+        b.journal.commit();
+    }
+
+    /* Flip a byte in the payload of the last record. */
+    std::string path = journalPath();
+    CHECK(!path.empty());
+    FILE *f = fopen(path.c_str(), "r+b");
+    CHECK(f != NULL);
+    if (f) {
+        fseek(f, -1, SEEK_END);
+        int c = fgetc(f);
+        fseek(f, -1, SEEK_END);
+        fputc(c ^ 0x20, f);
+        fclose(f);
+    }
+
+    Buffer b;
+    openBuffer(b);
+    CHECK(b.recovered == 9);
+    CHECK(rowText(b, 8) == "set 8");
+    CHECK(rowText(b, 9) == "line 9");
+    tearDown();
+}
+
+int main() {
+    testSecondEditorGoesWithout();
+    testDamagedRecordEndsReplay();
+    return CHECK_RESULT;
+}
@@ -0,0 +1,79 @@
+/*** includes ***/
+#include "lz.hpp"
+#include "check.hpp"
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/*** helpers ***/
+/* Compresses text and checks it decodes back byte for byte; returns the
+ * compressed size. */
+static size_t roundTrip(const std::string &text) {
+    std::string packed;
+    lzCompress(text.data(), text.size(), packed);
+    std::vector<char> out(text.size() + 1);
+    CHECK(lzDecompress(packed.data(), packed.size(), out.data(), text.size()) == 0);
+    CHECK(std::string(out.data(), text.size()) == text);
+    return packed.size();
+}
+
+static std::string randomBytes(size_t n) {
+    std::string s(n, '\0');
+    for (char &c : s) c = (char)(rand() & 0xff);
+    return s;
+}
+
+/*** tests ***/
+static void testShortInputs() {
+    CHECK(roundTrip("") == 1);
+    roundTrip("a");
+    roundTrip("abc");
+    roundTrip("abcd");
+    roundTrip("aaaaaaaa");
+}
+
+static void testRepetitive() {
+    std::string text;
+    for (int j = 0; j < 2000; j++) text += "    int x" + std::to_string(j % 10) + " = 0;\n";
+    CHECK(roundTrip(text) < text.size() / 4);
+
+    /* Runs longer than the 15 of a token need extra length bytes, and a
+     * match of offset 1 overlaps its own output. */
+    CHECK(roundTrip(std::string(100000, 'x')) < 1000);
+}
+
+/* Random bytes have nothing to match: the output is the literals and their
+ * length bytes, a little over the input. */
+static void testIncompressible() {
+    srand(7);
+    for (size_t n : { 15, 16, 270, 65536 + 300 }) {
+        std::string text = randomBytes(n);
+        size_t packed = roundTrip(text);
+        CHECK(packed <= n + n / 255 + 16);
+    }
+}
+
+/* Truncated or wrong-sized input fails instead of writing past dst. */
+static void testMalformed() {
+    std::string text;
+    for (int j = 0; j < 100; j++) text += "line " + std::to_string(j) + "\n";
+    std::string packed;
+    lzCompress(text.data(), text.size(), packed);
+
+    std::vector<char> out(text.size());
+    CHECK(lzDecompress(packed.data(), packed.size() - 1, out.data(), out.size()) == -1);
+    CHECK(lzDecompress(packed.data(), packed.size(), out.data(), out.size() - 1) == -1);
+
+    /* A match reaching back before the start of the output. */
+    const char bad[] = { 0x10, 'a', 0x05, 0x00 };
+    CHECK(lzDecompress(bad, sizeof(bad), out.data(), out.size()) == -1);
+}
+
+int main() {
+    testShortInputs();
+    testRepetitive();
+    testIncompressible();
+    testMalformed();
+    return CHECK_RESULT;
+}
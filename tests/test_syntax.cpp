@@ -0,0 +1,82 @@
+/*** includes ***/
+#include "buffer.hpp"
+#include "check.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/*** helpers ***/
+static void fill(Buffer &b, int nrows) {
+    b.filename = strdup("test.c");
+    b.editorSelectSyntaxHighlight();
+    for (int j = 0; j < nrows; j++) {
+        std::string line = "int x" + std::to_string(j) + " = " + std::to_string(j) + ";";
+        b.editorInsertRow(b.numrows, line.data(), line.size());
+    }
+}
+
+/* Every row's comment state and hl against a lex of the whole buffer from
+ * the top. */
+static int staleRows(Buffer &b) {
+    int stale = 0;
+    int in_comment = 0;
+    for (int j = 0; j < b.numrows; j++) {
+        trow_ *row = &b.rows[j];
+        b.editorRowPrepare(row);
+        std::vector<unsigned char> hl(row->r_size + 1);
+        in_comment = b.editorLexRow(row, hl.data(), in_comment);
+        if (row->hl_open_comment != in_comment || memcmp(row->hl, hl.data(), row->r_size)) stale++;
+    }
+    return stale;
+}
+
+/*** tests ***/
+static void testOpenerAboveLastRow() {
+    Buffer b;
+    fill(b, 20);
+    b.editorInsertRow(b.numrows - 1, "/*", 2);
+    CHECK(b.rows[b.numrows - 1].hl_open_comment == 1);
+    CHECK(b.rows[b.numrows - 1].hl[0] == HL_MLCOMMENT);
+    CHECK(staleRows(b) == 0);
+
+    /* Opened and closed on one row: the last row is out of the comment. */
+    b.editorDelRow(b.numrows - 2);
+    b.editorInsertRow(b.numrows - 1, "/*/**/", 6);
+    CHECK(b.rows[b.numrows - 1].hl_open_comment == 0);
+    CHECK(b.rows[b.numrows - 1].hl[0] != HL_MLCOMMENT);
+    CHECK(staleRows(b) == 0);
+}
+
+static void testAppendInsideComment() {
+    Buffer b;
+    fill(b, 5);
+    b.editorInsertRow(2, "/* open", 7);
+    b.editorInsertRow(b.numrows, "tail", 4);
+    CHECK(b.rows[b.numrows - 1].hl_open_comment == 1);
+    CHECK(b.rows[b.numrows - 1].hl[0] == HL_MLCOMMENT);
+    CHECK(staleRows(b) == 0);
+
+    b.editorInsertRow(b.numrows, "*/ int y;", 9);
+    CHECK(b.rows[b.numrows - 1].hl_open_comment == 0);
+    CHECK(staleRows(b) == 0);
+}
+
+static void testDeleteCloser() {
+    Buffer b;
+    fill(b, 10);
+    b.editorInsertRow(3, "/*", 2);
+    b.editorInsertRow(5, "*/", 2);
+    CHECK(staleRows(b) == 0);
+    b.editorDelRow(5);
+    CHECK(b.rows[b.numrows - 1].hl_open_comment == 1);
+    CHECK(staleRows(b) == 0);
+}
+
+int main() {
+    testOpenerAboveLastRow();
+    testAppendInsideComment();
+    testDeleteCloser();
+    return CHECK_RESULT;
+}
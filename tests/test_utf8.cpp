@@ -0,0 +1,91 @@
+/*** includes ***/
+#include "utf8.hpp"
+#include "check.hpp"
+
+#include <string.h>
+#include <string>
+
+/*** helpers ***/
+/* Decodes the first sequence of s, checking it takes len bytes. */
+static uint32_t decode(const char *s, int len) {
+    uint32_t cp;
+    CHECK(utf8Decode(s, strlen(s), &cp) == len);
+    return cp;
+}
+
+/*** tests ***/
+static void testValid() {
+    CHECK(decode("a", 1) == 'a');
+    CHECK(decode("\xC3\xA9", 2) == 0xE9);
+    CHECK(decode("\xE2\x82\xAC", 3) == 0x20AC);
+    CHECK(decode("\xF0\x9F\x98\x80", 4) == 0x1F600);
+    CHECK(decode("\xF4\x8F\xBF\xBF", 4) == 0x10FFFF);
+}
+
+/* Every malformed sequence decodes its first byte alone as invalid, so the
+ * caller steps over it and resyncs on the next byte. */
+static void testMalformed() {
+    CHECK(decode("\x80", 1) == UTF8_INVALID);
+    CHECK(decode("\xBF" "a", 1) == UTF8_INVALID);
+    CHECK(decode("\xC3", 1) == UTF8_INVALID);
+    CHECK(decode("\xE2\x82", 1) == UTF8_INVALID);
+    CHECK(decode("\xF0\x9F\x98", 1) == UTF8_INVALID);
+    CHECK(decode("\xC3" "a", 1) == UTF8_INVALID);
+    CHECK(decode("\xE2\x82" "a", 1) == UTF8_INVALID);
+
+    /* Overlong forms, surrogates, past U+10FFFF and never-valid bytes. */
+    CHECK(decode("\xC0\xAF", 1) == UTF8_INVALID);
+    CHECK(decode("\xC1\xBF", 1) == UTF8_INVALID);
+    CHECK(decode("\xE0\x80\xAF", 1) == UTF8_INVALID);
+    CHECK(decode("\xF0\x80\x80\xAF", 1) == UTF8_INVALID);
+    CHECK(decode("\xED\xA0\x80", 1) == UTF8_INVALID);
+    CHECK(decode("\xF4\x90\x80\x80", 1) == UTF8_INVALID);
+    CHECK(decode("\xF5\x80\x80\x80", 1) == UTF8_INVALID);
+    CHECK(decode("\xFF", 1) == UTF8_INVALID);
+
+    /* A sequence cut short by len, not by the text. */
+    uint32_t cp;
+    CHECK(utf8Decode("\xE2\x82\xAC", 2, &cp) == 1);
+    CHECK(cp == UTF8_INVALID);
+}
+
+static void testWidth() {
+    CHECK(utf8Width('a') == 1);
+    CHECK(utf8Width('\t') == -1);
+    CHECK(utf8Width(0x7F) == -1);
+    CHECK(utf8Width(0x85) == -1);
+    CHECK(utf8Width(0xE9) == 1);
+    CHECK(utf8Width(0x0301) == 0);
+    CHECK(utf8Width(0x4E2D) == 2);
+    CHECK(utf8Width(0x1F600) == 2);
+    CHECK(utf8Width(UTF8_INVALID) == -1);
+}
+
+static void testIsAscii() {
+    CHECK(utf8IsAscii("", 0));
+    std::string text(100, 'a');
+    CHECK(utf8IsAscii(text.data(), text.size()));
+
+    /* A high byte at every offset: in the 16-byte blocks, the 8-byte words
+     * and the tail. */
+    int missed = 0;
+    for (size_t j = 0; j < text.size(); j++) {
+        text[j] = '\xC3';
+        missed += utf8IsAscii(text.data(), text.size());
+        text[j] = 'a';
+    }
+    CHECK(missed == 0);
+
+    CHECK(utf8IsCont('\x80'));
+    CHECK(utf8IsCont('\xBF'));
+    CHECK(!utf8IsCont('a'));
+    CHECK(!utf8IsCont('\xC3'));
+}
+
+int main() {
+    testValid();
+    testMalformed();
+    testWidth();
+    testIsAscii();
+    return CHECK_RESULT;
+}